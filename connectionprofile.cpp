@@ -0,0 +1,102 @@
+#include "connectionprofile.h"
+#include <QSettings>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+static const QStringList JournalModes = {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"};
+static const QStringList SynchronousModes = {"OFF", "NORMAL", "FULL", "EXTRA"};
+static const QStringList TempStores = {"DEFAULT", "FILE", "MEMORY"};
+
+// Значение из настроек, если оно есть в списке допустимых, иначе fallback
+static QString allowedValue(const QSettings &settings, const QString &key,
+                            const QStringList &allowed, const QString &fallback)
+{
+    const QString value = settings.value(key, fallback).toString().trimmed().toUpper();
+    if (allowed.contains(value)) return value;
+
+    qDebug() << "Ignoring invalid database setting" << key << "=" << value;
+    return fallback;
+}
+
+QStringList ConnectionProfile::availableProfiles()
+{
+    return {"legacy", "safe", "balanced", "fast"};
+}
+
+ConnectionProfile ConnectionProfile::fromName(const QString &name)
+{
+    ConnectionProfile profile;
+
+    if (name == "legacy") {
+        // Значения SQLite по умолчанию
+        profile.name = name;
+        profile.journalMode = "DELETE";
+        profile.synchronous = "FULL";
+        profile.cacheSizeKb = 2000;
+        profile.mmapSize = 0;
+        profile.tempStore = "DEFAULT";
+    } else if (name == "safe") {
+        profile.name = name;
+        profile.synchronous = "FULL";
+        profile.cacheSizeKb = 4096;
+        profile.mmapSize = 0;
+    } else if (name == "fast") {
+        profile.name = name;
+        profile.cacheSizeKb = 32768;
+        profile.mmapSize = 256 * 1024 * 1024;
+    }
+
+    return profile;
+}
+
+ConnectionProfile ConnectionProfile::fromSettings()
+{
+    QSettings settings("sportTraining", "sportTraining");
+    settings.beginGroup("database");
+
+    ConnectionProfile profile = fromName(settings.value("profile", "balanced").toString());
+    profile.journalMode = allowedValue(settings, "journal_mode", JournalModes, profile.journalMode);
+    profile.synchronous = allowedValue(settings, "synchronous", SynchronousModes, profile.synchronous);
+    profile.cacheSizeKb = settings.value("cache_size_kb", profile.cacheSizeKb).toInt();
+    profile.mmapSize = settings.value("mmap_size", profile.mmapSize).toLongLong();
+    profile.tempStore = allowedValue(settings, "temp_store", TempStores, profile.tempStore);
+
+    settings.endGroup();
+    return profile;
+}
+
+bool ConnectionProfile::isValid() const
+{
+    return JournalModes.contains(journalMode)
+        && SynchronousModes.contains(synchronous)
+        && TempStores.contains(tempStore);
+}
+
+bool ConnectionProfile::apply(QSqlDatabase &db) const
+{
+    if (!isValid()) {
+        qDebug() << "Connection profile" << name << "has invalid values, not applied";
+        return false;
+    }
+
+    // Отрицательный cache_size задаёт размер кэша в КиБ, а не в страницах
+    const QStringList pragmas = {
+        QString("PRAGMA journal_mode = %1").arg(journalMode),
+        QString("PRAGMA synchronous = %1").arg(synchronous),
+        QString("PRAGMA cache_size = -%1").arg(cacheSizeKb),
+        QString("PRAGMA mmap_size = %1").arg(mmapSize),
+        QString("PRAGMA temp_store = %1").arg(tempStore)
+    };
+
+    QSqlQuery query(db);
+    for (const QString &pragma : pragmas) {
+        if (!query.exec(pragma)) {
+            qDebug() << "Failed to apply" << pragma << ":" << query.lastError().text();
+            return false;
+        }
+    }
+
+    qDebug() << "Connection profile applied:" << name;
+    return true;
+}
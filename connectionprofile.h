@@ -0,0 +1,30 @@
+#ifndef CONNECTIONPROFILE_H
+#define CONNECTIONPROFILE_H
+
+#include <QString>
+#include <QStringList>
+#include <QSqlDatabase>
+
+// Набор PRAGMA, применяемых к соединению SQLite при открытии.
+// Профиль выбирается в настройках (database/profile), отдельные
+// значения можно переопределить ключами database/journal_mode и т.д.
+// Строковые значения подставляются в SQL, поэтому допускаются только
+// известные SQLite варианты.
+struct ConnectionProfile
+{
+    QString name = "balanced";
+    QString journalMode = "WAL";
+    QString synchronous = "NORMAL";
+    int cacheSizeKb = 8192;
+    qint64 mmapSize = 64 * 1024 * 1024;
+    QString tempStore = "MEMORY";
+
+    static QStringList availableProfiles();
+    static ConnectionProfile fromName(const QString &name);
+    static ConnectionProfile fromSettings();
+
+    bool isValid() const;
+    bool apply(QSqlDatabase &db) const;
+};
+
+#endif // CONNECTIONPROFILE_H
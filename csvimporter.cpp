@@ -0,0 +1,176 @@
+#include "csvimporter.h"
+#include "database.h"
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+
+CsvImporter::CsvImporter(Database *database, QObject *parent)
+    : QObject(parent), database(database)
+{
+}
+
+void CsvImporter::setBatchSize(int size)
+{
+    m_batchSize = qMax(1, size);
+}
+
+int CsvImporter::batchSize() const
+{
+    return m_batchSize;
+}
+
+QVector<WorkoutData> CsvImporter::importedWorkouts() const
+{
+    return m_imported;
+}
+
+int CsvImporter::importedCount() const
+{
+    return m_imported.size();
+}
+
+int CsvImporter::skippedCount() const
+{
+    return m_skipped;
+}
+
+QString CsvImporter::lastError() const
+{
+    return m_lastError;
+}
+
+void CsvImporter::cancel()
+{
+    m_cancelled = true;
+}
+
+bool CsvImporter::import(const QString &fileName)
+{
+    m_imported.clear();
+    m_skipped = 0;
+    m_cancelled = false;
+    m_lastError.clear();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        m_lastError = file.errorString();
+        return false;
+    }
+
+    const qint64 totalBytes = file.size();
+    QTextStream in(&file);
+
+    QVector<WorkoutData> batch;
+    batch.reserve(m_batchSize);
+
+    bool firstLine = true;
+    QString line;
+    while (!m_cancelled && in.readLineInto(&line)) {
+        if (line.trimmed().isEmpty()) continue;
+
+        if (firstLine) {
+            // Разделитель определяем по первой строке
+            m_separator = line.count(QLatin1Char(',')) > line.count(QLatin1Char(';'))
+                        ? QLatin1Char(',') : QLatin1Char(';');
+        }
+
+        WorkoutData workout;
+        if (!parseLine(line, workout)) {
+            // Неразборчивая первая строка считается заголовком
+            if (!firstLine) ++m_skipped;
+            firstLine = false;
+            continue;
+        }
+        firstLine = false;
+
+        batch.append(workout);
+        if (batch.size() >= m_batchSize) {
+            if (!flushBatch(batch)) return false;
+            emit progress(m_imported.size(), file.pos(), totalBytes);
+        }
+    }
+
+    // При отмене незаписанный хвост отбрасываем, записанные пачки остаются
+    if (!m_cancelled && !batch.isEmpty()) {
+        if (!flushBatch(batch)) return false;
+    }
+    emit progress(m_imported.size(), totalBytes, totalBytes);
+
+    qDebug() << "CSV import finished. Imported:" << m_imported.size() << "Skipped:" << m_skipped;
+    return true;
+}
+
+bool CsvImporter::flushBatch(QVector<WorkoutData> &batch)
+{
+    if (!database->addWorkouts(batch)) {
+        m_lastError = database->lastError();
+        return false;
+    }
+    m_imported += batch;
+    batch.clear();
+    return true;
+}
+
+bool CsvImporter::parseLine(const QString &line, WorkoutData &workout) const
+{
+    const QStringList fields = splitLine(line);
+    if (fields.size() < 3) return false;
+
+    const QString dateText = fields.at(0).trimmed();
+    workout.date = QDate::fromString(dateText, Qt::ISODate);
+    if (!workout.date.isValid()) {
+        workout.date = QDate::fromString(dateText, "dd.MM.yyyy");
+    }
+    if (!workout.date.isValid()) return false;
+
+    workout.type = fields.at(1).trimmed();
+    if (workout.type.isEmpty()) return false;
+
+    bool ok = false;
+    workout.duration = fields.at(2).trimmed().toInt(&ok);
+    if (!ok) return false;
+
+    auto intField = [&fields](int index) {
+        return index < fields.size() ? fields.at(index).trimmed().toInt() : 0;
+    };
+    workout.sets = intField(3);
+    workout.reps = intField(4);
+    workout.calories = intField(5);
+
+    // Заметки могут содержать разделитель без кавычек
+    workout.notes = fields.size() > 6 ? fields.mid(6).join(m_separator).trimmed() : QString();
+    return true;
+}
+
+QStringList CsvImporter::splitLine(const QString &line) const
+{
+    QStringList fields;
+    QString field;
+    bool inQuotes = false;
+
+    for (int i = 0; i < line.size(); ++i) {
+        const QChar c = line.at(i);
+        if (inQuotes) {
+            if (c == QLatin1Char('"')) {
+                // Удвоенная кавычка внутри поля
+                if (i + 1 < line.size() && line.at(i + 1) == QLatin1Char('"')) {
+                    field += c;
+                    ++i;
+                } else {
+                    inQuotes = false;
+                }
+            } else {
+                field += c;
+            }
+        } else if (c == QLatin1Char('"')) {
+            inQuotes = true;
+        } else if (c == m_separator) {
+            fields.append(field);
+            field.clear();
+        } else {
+            field += c;
+        }
+    }
+    fields.append(field);
+    return fields;
+}
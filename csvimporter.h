@@ -0,0 +1,51 @@
+#ifndef CSVIMPORTER_H
+#define CSVIMPORTER_H
+
+#include <QObject>
+#include <QVector>
+#include <QStringList>
+#include "mainwindow.h"
+
+class Database;
+
+// Потоковый импорт тренировок из CSV.
+// Формат строки: дата;тип;длительность;подходы;повторения;ккал;заметки
+// (разделитель ';' или ','), дата в виде yyyy-MM-dd или dd.MM.yyyy.
+class CsvImporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CsvImporter(Database *database, QObject *parent = nullptr);
+
+    void setBatchSize(int size);
+    int batchSize() const;
+
+    bool import(const QString &fileName);
+
+    QVector<WorkoutData> importedWorkouts() const;
+    int importedCount() const;
+    int skippedCount() const;
+    QString lastError() const;
+
+public slots:
+    void cancel();
+
+signals:
+    void progress(int rowsImported, qint64 bytesRead, qint64 totalBytes);
+
+private:
+    bool parseLine(const QString &line, WorkoutData &workout) const;
+    QStringList splitLine(const QString &line) const;
+    bool flushBatch(QVector<WorkoutData> &batch);
+
+    Database *database;
+    int m_batchSize = 1000;
+    QChar m_separator = QLatin1Char(';');
+    bool m_cancelled = false;
+    int m_skipped = 0;
+    QString m_lastError;
+    QVector<WorkoutData> m_imported;
+};
+
+#endif // CSVIMPORTER_H
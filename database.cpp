@@ -1,15 +1,42 @@
 #include "database.h"
 #include "mainwindow.h"
+#include "connectionprofile.h"
+#include "workoutstore.h"
 #include <QDir>
 #include <QDebug>
+#include <QSqlRecord>
+#include <limits>
 
-Database::Database(QObject *parent) : QObject(parent)
+// Версия схемы, хранится в PRAGMA user_version.
+// 0 - исходная схема с датой в виде TEXT "yyyy-MM-dd"
+// 1 - дата хранится как номер юлианского дня (INTEGER) с индексом
+// 2 - дневная сводка rollup_day
+static const int SchemaVersion = 2;
+
+// Сводка по виду спорта за день; period - номер дня
+static QString rollupTableSql(const QString &table)
+{
+    return QString("CREATE TABLE %1 ("
+                   "type TEXT NOT NULL, "
+                   "period INTEGER NOT NULL, "
+                   "count INTEGER NOT NULL, "
+                   "duration INTEGER NOT NULL, "
+                   "calories INTEGER NOT NULL, "
+                   "PRIMARY KEY (type, period)) WITHOUT ROWID").arg(table);
+}
+
+Database::Database(QObject *parent, const QString &connectionName) : QObject(parent)
 {
+    // Без имени используется соединение по умолчанию.
+    // Соединение можно использовать только в потоке, где создан Database.
+    const QString name = connectionName.isEmpty() ? QString("qt_sql_default_connection")
+                                                  : connectionName;
+
     // Убедимся, что соединение с таким именем не существует
-    if(QSqlDatabase::contains("qt_sql_default_connection")) {
-        db = QSqlDatabase::database("qt_sql_default_connection");
+    if(QSqlDatabase::contains(name)) {
+        db = QSqlDatabase::database(name);
     } else {
-        db = QSqlDatabase::addDatabase("QSQLITE");
+        db = QSqlDatabase::addDatabase("QSQLITE", name);
         db.setDatabaseName("workout_tracker.db");
     }
 
@@ -21,44 +48,49 @@ Database::Database(QObject *parent) : QObject(parent)
     }
 
     if (!checkTables()) {
-        qDebug() << "Table 'workouts' doesn't exist. Creating...";
-        QSqlQuery query(db);
-        if (!query.exec("CREATE TABLE workouts ("
-                       "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                       "type TEXT NOT NULL, "
-                       "duration INTEGER NOT NULL, "
-                       "sets INTEGER, "
-                       "reps INTEGER, "
-                       "calories INTEGER, "
-                       "notes TEXT, "
-                       "date TEXT NOT NULL)")) {
-            qDebug() << "Failed to create table:" << query.lastError().text();
-        }
+        qDebug() << "Failed to prepare database schema:" << db.lastError().text();
     }
 }
 
 Database::~Database()
 {
-
+    qDeleteAll(statements);
 }
 
 bool Database::openDatabase()
 {
+    // Повторное открытие закрыло бы соединение и сбросило подготовленные запросы
+    if (db.isOpen()) return true;
+
     if (!db.open()) {
         qDebug() << "Error: connection with database failed";
         return false;
     }
+
+    qDeleteAll(statements);
+    statements.clear();
+
+    // Без профиля соединение работает на значениях SQLite по умолчанию
+    if (!ConnectionProfile::fromSettings().apply(db)) {
+        qDebug() << "Falling back to the default connection profile";
+        if (!ConnectionProfile().apply(db)) {
+            qDebug() << "Default connection profile failed, using SQLite defaults";
+        }
+    }
     return true;
 }
 
 void Database::closeDatabase()
 {
+    // Подготовленные запросы должны быть освобождены до закрытия соединения
+    qDeleteAll(statements);
+    statements.clear();
     if (db.isOpen()) {
         db.close();
     }
 }
 
-bool Database::addWorkout(const WorkoutData &workout)
+bool Database::addWorkout(WorkoutData &workout)
 {
     if (!db.isOpen()) {
         qDebug() << "Database is not open! Attempting to reopen...";
@@ -75,86 +107,307 @@ bool Database::addWorkout(const WorkoutData &workout)
     qDebug() << "Reps:" << workout.reps;
     qDebug() << "Calories:" << workout.calories;
     qDebug() << "Notes:" << workout.notes;
-    qDebug() << "Date:" << workout.date.toString("yyyy-MM-dd");
+    qDebug() << "Date:" << workout.date;
 
-    QSqlQuery query;
-    QString sql = "INSERT INTO workouts (type, duration, sets, reps, calories, notes, date) "
-                  "VALUES (:type, :duration, :sets, :reps, :calories, :notes, :date)";
+    // Запись и сводные таблицы обновляются в одной транзакции
+    if (!db.transaction()) {
+        qDebug() << "Failed to start transaction:" << db.lastError().text();
+        return false;
+    }
 
-    qDebug() << "Preparing SQL:" << sql;
+    if (!insertWorkout(workout) || !db.commit()) {
+        db.rollback();
+        return false;
+    }
 
-    if (!query.prepare(sql)) {
-        qDebug() << "Prepare failed:" << query.lastError().text();
+    qDebug() << "Workout added successfully! Id:" << workout.id;
+    return true;
+}
+
+bool Database::addWorkouts(QVector<WorkoutData> &workouts)
+{
+    if (!db.isOpen() && !openDatabase()) {
         return false;
     }
 
-    query.bindValue(":type", workout.type);
-    query.bindValue(":duration", workout.duration);
-    query.bindValue(":sets", workout.sets);
-    query.bindValue(":reps", workout.reps);
-    query.bindValue(":calories", workout.calories);
-    query.bindValue(":notes", workout.notes);
-    query.bindValue(":date", workout.date.toString("yyyy-MM-dd"));
+    // Вся пачка пишется одной транзакцией, чтобы не делать fsync на каждую строку
+    if (!db.transaction()) {
+        qDebug() << "Failed to start transaction:" << db.lastError().text();
+        return false;
+    }
 
-    if (!query.exec()) {
-        qDebug() << "Execution failed:" << query.lastError().text();
-        qDebug() << "Last query:" << query.lastQuery();
-        qDebug() << "Bound values:" << query.boundValues();
+    for (WorkoutData &workout : workouts) {
+        if (!insertWorkout(workout)) {
+            db.rollback();
+            return false;
+        }
+    }
+
+    if (!db.commit()) {
+        qDebug() << "Batch commit failed:" << db.lastError().text();
+        db.rollback();
+        return false;
+    }
+    return true;
+}
+
+bool Database::insertWorkout(WorkoutData &workout)
+{
+    QSqlQuery *query = preparedQuery(
+        "INSERT INTO workouts (type, duration, sets, reps, calories, notes, day) "
+        "VALUES (:type, :duration, :sets, :reps, :calories, :notes, :day)");
+    if (!query) return false;
+
+    query->bindValue(":type", workout.type);
+    query->bindValue(":duration", workout.duration);
+    query->bindValue(":sets", workout.sets);
+    query->bindValue(":reps", workout.reps);
+    query->bindValue(":calories", workout.calories);
+    query->bindValue(":notes", workout.notes);
+    query->bindValue(":day", workout.date.toJulianDay());
+
+    if (!query->exec()) {
+        qDebug() << "Execution failed:" << query->lastError().text();
+        qDebug() << "Last query:" << query->lastQuery();
+        qDebug() << "Bound values:" << query->boundValues();
+        return false;
+    }
+
+    workout.id = query->lastInsertId().toInt();
+    return applyRollup(workout.type, workout.date, 1, workout.duration, workout.calories);
+}
+
+bool Database::fetchRollupSource(int id, QString &type, QDate &date, int &duration, int &calories)
+{
+    QSqlQuery *query = preparedQuery(
+        "SELECT type, day, duration, calories FROM workouts WHERE id = :id");
+    if (!query) return false;
+
+    query->bindValue(":id", id);
+    if (!query->exec() || !query->next()) {
+        qDebug() << "Workout not found:" << id << query->lastError().text();
+        query->finish();
         return false;
     }
 
-    qDebug() << "Workout added successfully!";
+    type = query->value(0).toString();
+    date = QDate::fromJulianDay(query->value(1).toLongLong());
+    duration = query->value(2).toInt();
+    calories = query->value(3).toInt();
+    query->finish();
     return true;
 }
 
-QVector<WorkoutData> Database::getAllWorkouts()
+bool Database::applyRollup(const QString &type, const QDate &date, int count, int duration, int calories)
 {
-    QVector<WorkoutData> workouts;
-    if (!db.isOpen() && !openDatabase()) {
-        return workouts;
+    // Ключ - номер дня
+    QSqlQuery *upsert = preparedQuery(
+        "INSERT INTO rollup_day (type, period, count, duration, calories) "
+        "VALUES (:type, :period, :count, :duration, :calories) "
+        "ON CONFLICT(type, period) DO UPDATE SET "
+        "count = count + excluded.count, "
+        "duration = duration + excluded.duration, "
+        "calories = calories + excluded.calories");
+    if (!upsert) return false;
+
+    upsert->bindValue(":type", type);
+    upsert->bindValue(":period", date.toJulianDay());
+    upsert->bindValue(":count", count);
+    upsert->bindValue(":duration", duration);
+    upsert->bindValue(":calories", calories);
+    if (!upsert->exec()) {
+        qDebug() << "Rollup update failed:" << upsert->lastError().text();
+        return false;
+    }
+
+    if (count < 0) {
+        QSqlQuery *cleanup = preparedQuery(
+            "DELETE FROM rollup_day WHERE type = :type AND period = :period AND count <= 0");
+        if (!cleanup) return false;
+
+        cleanup->bindValue(":type", type);
+        cleanup->bindValue(":period", date.toJulianDay());
+        if (!cleanup->exec()) {
+            qDebug() << "Rollup cleanup failed:" << cleanup->lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+int Database::countWorkouts(const QString &condition, const QVariantList &values)
+{
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT COUNT(*) FROM workouts" + condition);
+    for (const QVariant &value : values) {
+        query.addBindValue(value);
+    }
+    if (!query.exec() || !query.next()) {
+        return 0;
     }
+    return query.value(0).toInt();
+}
 
+template <typename Sink>
+bool Database::readWorkouts(const QString &condition, const QVariantList &values,
+                            bool withNotes, Sink sink)
+{
+    // Результат читаем только вперёд, без кэширования строк в драйвере
     QSqlQuery query(db);
-    if (!query.exec("SELECT * FROM workouts ORDER BY date DESC")) {
+    query.setForwardOnly(true);
+    query.prepare(QString("SELECT id, type, duration, sets, reps, calories, %1day FROM workouts")
+                  .arg(QString(withNotes ? "notes, " : ""))
+                  + condition + " ORDER BY day DESC");
+    for (const QVariant &value : values) {
+        query.addBindValue(value);
+    }
+
+    if (!query.exec()) {
         qDebug() << "Query failed:" << query.lastError().text();
-        return workouts;
+        return false;
     }
 
+    // Индексы столбцов находим один раз, а не по имени на каждую строку
+    const QSqlRecord record = query.record();
+    const int idColumn = record.indexOf("id");
+    const int typeColumn = record.indexOf("type");
+    const int durationColumn = record.indexOf("duration");
+    const int setsColumn = record.indexOf("sets");
+    const int repsColumn = record.indexOf("reps");
+    const int caloriesColumn = record.indexOf("calories");
+    const int notesColumn = record.indexOf("notes");
+    const int dayColumn = record.indexOf("day");
+
+    WorkoutData workout;
     while (query.next()) {
-        WorkoutData workout;
-        workout.id = query.value("id").toInt();
-        workout.type = query.value("type").toString();
-        workout.duration = query.value("duration").toInt();
-        workout.sets = query.value("sets").toInt();
-        workout.reps = query.value("reps").toInt();
-        workout.calories = query.value("calories").toInt();
-        workout.notes = query.value("notes").toString();
-        workout.date = QDate::fromString(query.value("date").toString(), "yyyy-MM-dd");
-
-        workouts.append(workout);
+        workout.id = query.value(idColumn).toInt();
+        workout.type = query.value(typeColumn).toString();
+        workout.duration = query.value(durationColumn).toInt();
+        workout.sets = query.value(setsColumn).toInt();
+        workout.reps = query.value(repsColumn).toInt();
+        workout.calories = query.value(caloriesColumn).toInt();
+        if (notesColumn >= 0) {
+            workout.notes = query.value(notesColumn).toString();
+        }
+        workout.date = QDate::fromJulianDay(query.value(dayColumn).toLongLong());
+        sink(std::move(workout));
     }
+    return true;
+}
+
+QVector<WorkoutData> Database::loadWorkouts(const QString &condition, const QVariantList &values)
+{
+    QVector<WorkoutData> workouts;
+    if (!db.isOpen() && !openDatabase()) {
+        return workouts;
+    }
+
+    // Размер результата узнаём заранее, чтобы выделить память один раз
+    workouts.reserve(countWorkouts(condition, values));
+    readWorkouts(condition, values, true, [&workouts](WorkoutData &&workout) {
+        workouts.append(std::move(workout));
+    });
     return workouts;
 }
 
+QVector<WorkoutData> Database::getAllWorkouts()
+{
+    return loadWorkouts(QString(), QVariantList());
+}
+
+QVector<WorkoutData> Database::getWorkoutsInRange(const QDate &from, const QDate &to)
+{
+    return loadWorkouts(" WHERE day BETWEEN ? AND ?", {from.toJulianDay(), to.toJulianDay()});
+}
+
+int Database::getWorkoutsInRange(const QDate &from, const QDate &to, WorkoutStore &store)
+{
+    if (!db.isOpen() && !openDatabase()) {
+        return 0;
+    }
+
+    // Строки раскладываются по колонкам хранилища без промежуточного вектора.
+    // Заметки не читаются: хранилище загрузит их по требованию.
+    int loaded = 0;
+    readWorkouts(" WHERE day BETWEEN ? AND ?", {from.toJulianDay(), to.toJulianDay()}, false,
+                 [&store, &loaded](WorkoutData &&workout) {
+        store.insert(workout, false);
+        ++loaded;
+    });
+    return loaded;
+}
+
+QString Database::getWorkoutNotes(int id)
+{
+    if (!db.isOpen() && !openDatabase()) {
+        return QString();
+    }
+
+    QSqlQuery *query = preparedQuery("SELECT notes FROM workouts WHERE id = :id");
+    if (!query) return QString();
+
+    query->bindValue(":id", id);
+    QString notes;
+    if (query->exec() && query->next()) {
+        notes = query->value(0).toString();
+    }
+    query->finish();
+    return notes;
+}
+
+QVector<WorkoutData> Database::getWorkoutsForDay(const QDate &day)
+{
+    return getWorkoutsInRange(day, day);
+}
+
 bool Database::updateWorkout(const WorkoutData &workout)
 {
     if (!db.isOpen()) return false;
 
-    QSqlQuery query;
-    query.prepare("UPDATE workouts SET type = :type, duration = :duration, sets = :sets, "
-                  "reps = :reps, calories = :calories, notes = :notes, date = :date "
-                  "WHERE id = :id");
-    query.bindValue(":type", workout.type);
-    query.bindValue(":duration", workout.duration);
-    query.bindValue(":sets", workout.sets);
-    query.bindValue(":reps", workout.reps);
-    query.bindValue(":calories", workout.calories);
-    query.bindValue(":notes", workout.notes);
-    query.bindValue(":date", workout.date.toString("yyyy-MM-dd"));
-    query.bindValue(":id", workout.id);
+    if (!db.transaction()) {
+        qDebug() << "Failed to start transaction:" << db.lastError().text();
+        return false;
+    }
 
-    if (!query.exec()) {
-        qDebug() << "Update workout error:" << query.lastError();
+    // Старые значения вычитаем из сводных таблиц, новые прибавляем
+    QString oldType;
+    QDate oldDate;
+    int oldDuration = 0;
+    int oldCalories = 0;
+    if (!fetchRollupSource(workout.id, oldType, oldDate, oldDuration, oldCalories)
+        || !applyRollup(oldType, oldDate, -1, -oldDuration, -oldCalories)) {
+        db.rollback();
+        return false;
+    }
+
+    QSqlQuery *query = preparedQuery(
+        "UPDATE workouts SET type = :type, duration = :duration, sets = :sets, "
+        "reps = :reps, calories = :calories, notes = :notes, day = :day "
+        "WHERE id = :id");
+    if (!query) {
+        db.rollback();
+        return false;
+    }
+
+    query->bindValue(":type", workout.type);
+    query->bindValue(":duration", workout.duration);
+    query->bindValue(":sets", workout.sets);
+    query->bindValue(":reps", workout.reps);
+    query->bindValue(":calories", workout.calories);
+    query->bindValue(":notes", workout.notes);
+    query->bindValue(":day", workout.date.toJulianDay());
+    query->bindValue(":id", workout.id);
+
+    if (!query->exec()) {
+        qDebug() << "Update workout error:" << query->lastError();
+        db.rollback();
+        return false;
+    }
+
+    if (!applyRollup(workout.type, workout.date, 1, workout.duration, workout.calories)
+        || !db.commit()) {
+        db.rollback();
         return false;
     }
     return true;
@@ -164,15 +417,103 @@ bool Database::deleteWorkout(int id)
 {
     if (!db.isOpen()) return false;
 
-    QSqlQuery query;
-    query.prepare("DELETE FROM workouts WHERE id = :id");
-    query.bindValue(":id", id);
+    if (!db.transaction()) {
+        qDebug() << "Failed to start transaction:" << db.lastError().text();
+        return false;
+    }
 
-    if (!query.exec()) {
-        qDebug() << "Delete workout error:" << query.lastError();
+    QString type;
+    QDate date;
+    int duration = 0;
+    int calories = 0;
+    if (!fetchRollupSource(id, type, date, duration, calories)
+        || !applyRollup(type, date, -1, -duration, -calories)) {
+        db.rollback();
         return false;
     }
-    return true;
+
+    QSqlQuery *query = preparedQuery("DELETE FROM workouts WHERE id = :id");
+    if (!query) {
+        db.rollback();
+        return false;
+    }
+
+    query->bindValue(":id", id);
+
+    if (!query->exec()) {
+        qDebug() << "Delete workout error:" << query->lastError();
+        db.rollback();
+        return false;
+    }
+    return db.commit();
+}
+
+QVector<RollupRow> Database::getRollups(const QString &type, const QDate &from, const QDate &to)
+{
+    QVector<RollupRow> rows;
+    if (!db.isOpen() && !openDatabase()) {
+        return rows;
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT period, count, duration, calories FROM rollup_day "
+                  "WHERE type = ? AND period BETWEEN ? AND ? ORDER BY period");
+    query.addBindValue(type);
+    query.addBindValue(from.isValid() ? from.toJulianDay() : std::numeric_limits<qint64>::min());
+    query.addBindValue(to.isValid() ? to.toJulianDay() : std::numeric_limits<qint64>::max());
+
+    if (!query.exec()) {
+        qDebug() << "Rollup query failed:" << query.lastError().text();
+        return rows;
+    }
+
+    while (query.next()) {
+        RollupRow &row = rows.emplaceBack();
+        row.period = QDate::fromJulianDay(query.value(0).toLongLong());
+        row.count = query.value(1).toInt();
+        row.duration = query.value(2).toLongLong();
+        row.calories = query.value(3).toLongLong();
+    }
+    return rows;
+}
+
+QStringList Database::getWorkoutTypes()
+{
+    QStringList types;
+    if (!db.isOpen() && !openDatabase()) {
+        return types;
+    }
+
+    // Ключ сводки начинается с типа, поэтому DISTINCT идёт по ключу без сортировки
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT DISTINCT type FROM rollup_day WHERE type <> '' ORDER BY type")) {
+        qDebug() << "Types query failed:" << query.lastError().text();
+        return types;
+    }
+
+    while (query.next()) {
+        types.append(query.value(0).toString());
+    }
+    return types;
+}
+
+QSqlQuery *Database::preparedQuery(const QString &sql)
+{
+    // Запрос готовится один раз за время жизни соединения,
+    // дальше к нему только заново привязываются значения
+    QSqlQuery *query = statements.value(sql);
+    if (!query) {
+        query = new QSqlQuery(db);
+        if (!query->prepare(sql)) {
+            qDebug() << "Prepare failed:" << query->lastError().text();
+            delete query;
+            return nullptr;
+        }
+        statements.insert(sql, query);
+    }
+    return query;
 }
 
 QString Database::lastError() const
@@ -184,5 +525,145 @@ bool Database::checkTables()
 {
     if (!db.isOpen()) return false;
 
-    return db.tables().contains("workouts");
+    if (!db.tables().contains("workouts")) {
+        qDebug() << "Table 'workouts' doesn't exist. Creating...";
+        return createSchema();
+    }
+
+    int version = schemaVersion();
+    if (version < 1 && !migrateToDayNumbers()) {
+        return false;
+    }
+    if (version < 2 && !migrateRollups()) {
+        return false;
+    }
+    return true;
+}
+
+int Database::schemaVersion()
+{
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA user_version") || !query.next()) {
+        qDebug() << "Failed to read schema version:" << query.lastError().text();
+        return 0;
+    }
+    return query.value(0).toInt();
+}
+
+bool Database::execStatements(const QStringList &statements)
+{
+    QSqlQuery query(db);
+    for (const QString &sql : statements) {
+        if (!query.exec(sql)) {
+            qDebug() << "Schema statement failed:" << sql << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Database::createSchema()
+{
+    return execStatements({
+        "CREATE TABLE workouts ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "type TEXT NOT NULL, "
+        "duration INTEGER NOT NULL, "
+        "sets INTEGER, "
+        "reps INTEGER, "
+        "calories INTEGER, "
+        "notes TEXT, "
+        "day INTEGER NOT NULL)",
+        "CREATE INDEX idx_workouts_day ON workouts(day)",
+        rollupTableSql("rollup_day"),
+        QString("PRAGMA user_version = %1").arg(SchemaVersion)
+    });
+}
+
+bool Database::migrateToDayNumbers()
+{
+    qDebug() << "Migrating 'workouts' to integer day numbers...";
+
+    // SQLite не умеет менять тип столбца, поэтому пересобираем таблицу.
+    // julianday() возвращает полночь (x.5), QDate::toJulianDay() - целый номер дня.
+    if (!db.transaction()) {
+        qDebug() << "Failed to start migration:" << db.lastError().text();
+        return false;
+    }
+
+    // Строки с неразборчивой датой не переносятся: сохраняем их
+    // в отдельной таблице, чтобы не потерять данные пользователя
+    QSqlQuery invalid(db);
+    if (!invalid.exec("SELECT id FROM workouts WHERE julianday(date) IS NULL")) {
+        qDebug() << "Failed to check workout dates:" << invalid.lastError().text();
+        db.rollback();
+        return false;
+    }
+    QStringList invalidIds;
+    while (invalid.next()) {
+        invalidIds.append(invalid.value(0).toString());
+    }
+    invalid.finish();
+
+    if (!invalidIds.isEmpty()) {
+        qDebug() << "Workouts with unparsable dates:" << invalidIds.size()
+                 << "ids:" << invalidIds.join(", ")
+                 << "- kept in 'workouts_unmigrated'";
+        if (!execStatements({"CREATE TABLE workouts_unmigrated AS "
+                             "SELECT * FROM workouts WHERE julianday(date) IS NULL"})) {
+            db.rollback();
+            return false;
+        }
+    }
+
+    bool ok = execStatements({
+        "CREATE TABLE workouts_new ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "type TEXT NOT NULL, "
+        "duration INTEGER NOT NULL, "
+        "sets INTEGER, "
+        "reps INTEGER, "
+        "calories INTEGER, "
+        "notes TEXT, "
+        "day INTEGER NOT NULL)",
+        "INSERT INTO workouts_new (id, type, duration, sets, reps, calories, notes, day) "
+        "SELECT id, type, duration, sets, reps, calories, notes, "
+        "CAST(julianday(date) + 0.5 AS INTEGER) FROM workouts "
+        "WHERE julianday(date) IS NOT NULL",
+        "DROP TABLE workouts",
+        "ALTER TABLE workouts_new RENAME TO workouts",
+        "CREATE INDEX idx_workouts_day ON workouts(day)",
+        "PRAGMA user_version = 1"
+    });
+
+    if (!ok || !db.commit()) {
+        db.rollback();
+        return false;
+    }
+    return true;
+}
+
+bool Database::migrateRollups()
+{
+    qDebug() << "Building rollup tables...";
+
+    if (!db.transaction()) {
+        qDebug() << "Failed to start migration:" << db.lastError().text();
+        return false;
+    }
+
+    // Однократное заполнение дневной сводки по уже накопленной истории
+    bool ok = execStatements({
+        rollupTableSql("rollup_day"),
+        "INSERT INTO rollup_day (type, period, count, duration, calories) "
+        "SELECT type, day, COUNT(*), SUM(duration), SUM(COALESCE(calories, 0)) "
+        "FROM workouts GROUP BY type, day",
+        "PRAGMA user_version = 2"
+    });
+
+    if (!ok || !db.commit()) {
+        db.rollback();
+        return false;
+    }
+    return true;
 }
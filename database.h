@@ -6,30 +6,68 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
+#include <QDate>
+#include <QVector>
+#include <QStringList>
+#include <QHash>
+#include <QVariantList>
 
 // Предварительное объявление структуры WorkoutData
 struct WorkoutData;
+class WorkoutStore;
+
+// Строка дневной сводки по виду спорта
+struct RollupRow {
+    QDate period;         // день
+    int count = 0;
+    qint64 duration = 0;
+    qint64 calories = 0;
+};
 
 class Database : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit Database(QObject *parent = nullptr);
+    explicit Database(QObject *parent = nullptr, const QString &connectionName = QString());
     ~Database();
 
     bool openDatabase();
     void closeDatabase();
     QString lastError() const;
 
-    bool addWorkout(const WorkoutData &workout);
+    bool addWorkout(WorkoutData &workout);
+    bool addWorkouts(QVector<WorkoutData> &workouts);
     QVector<WorkoutData> getAllWorkouts();
+    QVector<WorkoutData> getWorkoutsInRange(const QDate &from, const QDate &to);
+    int getWorkoutsInRange(const QDate &from, const QDate &to, WorkoutStore &store);
+    QVector<WorkoutData> getWorkoutsForDay(const QDate &day);
+    QString getWorkoutNotes(int id);
     bool updateWorkout(const WorkoutData &workout);
     bool deleteWorkout(int id);
 
+    // Невалидная граница означает диапазон без ограничения с этой стороны
+    QVector<RollupRow> getRollups(const QString &type, const QDate &from, const QDate &to);
+    QStringList getWorkoutTypes();
+
 private:
     bool checkTables();
+    int schemaVersion();
+    bool execStatements(const QStringList &statements);
+    bool createSchema();
+    bool migrateToDayNumbers();
+    bool migrateRollups();
+    bool insertWorkout(WorkoutData &workout);
+    bool fetchRollupSource(int id, QString &type, QDate &date, int &duration, int &calories);
+    bool applyRollup(const QString &type, const QDate &date, int count, int duration, int calories);
+    QSqlQuery *preparedQuery(const QString &sql);
+    QVector<WorkoutData> loadWorkouts(const QString &condition, const QVariantList &values);
+    int countWorkouts(const QString &condition, const QVariantList &values);
+    template <typename Sink>
+    bool readWorkouts(const QString &condition, const QVariantList &values,
+                      bool withNotes, Sink sink);
     QSqlDatabase db;
+    QHash<QString, QSqlQuery*> statements;
 };
 
 #endif // DATABASE_H
@@ -0,0 +1,112 @@
+#include "databasewriter.h"
+#include "database.h"
+#include <QPromise>
+#include <QSharedPointer>
+#include <QSqlDatabase>
+#include <QDebug>
+
+static const char *WriterConnectionName = "workout_tracker_writer";
+
+DatabaseWriter::DatabaseWriter(QObject *parent)
+    : QObject(parent), context(new QObject())
+{
+    workerThread.setObjectName("DatabaseWriter");
+    context->moveToThread(&workerThread);
+    workerThread.start();
+}
+
+DatabaseWriter::~DatabaseWriter()
+{
+    // Дожидаемся выполнения очереди и закрываем соединение в его потоке
+    QMetaObject::invokeMethod(context, [this]() {
+        delete database;
+        database = nullptr;
+        QSqlDatabase::removeDatabase(WriterConnectionName);
+    }, Qt::BlockingQueuedConnection);
+
+    workerThread.quit();
+    workerThread.wait();
+    delete context;
+}
+
+template <typename T, typename Function>
+QFuture<T> DatabaseWriter::enqueue(Function function)
+{
+    auto promise = QSharedPointer<QPromise<T>>::create();
+    QFuture<T> future = promise->future();
+    promise->start();
+
+    QMetaObject::invokeMethod(context, [promise, function]() mutable {
+        promise->addResult(function());
+        promise->finish();
+    }, Qt::QueuedConnection);
+
+    return future;
+}
+
+Database *DatabaseWriter::connection()
+{
+    // Соединение создаётся в потоке записи и используется только в нём
+    if (!database) {
+        database = new Database(nullptr, WriterConnectionName);
+    }
+    return database;
+}
+
+int DatabaseWriter::resolveId(int id) const
+{
+    return provisionalIds.value(id, id);
+}
+
+QFuture<int> DatabaseWriter::addWorkout(const WorkoutData &workout)
+{
+    return enqueue<int>([this, workout]() mutable {
+        const int provisionalId = workout.id;
+        if (!connection()->addWorkout(workout)) {
+            emit error(QString("Не удалось добавить тренировку: %1").arg(connection()->lastError()));
+            return -1;
+        }
+        if (provisionalId < -1) {
+            provisionalIds.insert(provisionalId, workout.id);
+        }
+        return workout.id;
+    });
+}
+
+QFuture<bool> DatabaseWriter::updateWorkout(const WorkoutData &workout)
+{
+    return enqueue<bool>([this, workout]() mutable {
+        workout.id = resolveId(workout.id);
+        if (workout.id < 0 || !connection()->updateWorkout(workout)) {
+            emit error(QString("Не удалось обновить тренировку: %1").arg(connection()->lastError()));
+            return false;
+        }
+        return true;
+    });
+}
+
+QFuture<bool> DatabaseWriter::deleteWorkout(int id)
+{
+    return enqueue<bool>([this, id]() {
+        const int realId = resolveId(id);
+        if (realId < 0 || !connection()->deleteWorkout(realId)) {
+            emit error(QString("Не удалось удалить тренировку: %1").arg(connection()->lastError()));
+            return false;
+        }
+        return true;
+    });
+}
+
+QFuture<QVector<WorkoutData>> DatabaseWriter::getAllWorkouts()
+{
+    return enqueue<QVector<WorkoutData>>([this]() {
+        return connection()->getAllWorkouts();
+    });
+}
+
+QFuture<bool> DatabaseWriter::sync()
+{
+    return enqueue<bool>([]() {
+        return true;
+    });
+}
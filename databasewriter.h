@@ -0,0 +1,54 @@
+#ifndef DATABASEWRITER_H
+#define DATABASEWRITER_H
+
+#include <QObject>
+#include <QThread>
+#include <QFuture>
+#include <QHash>
+#include <QVector>
+#include "mainwindow.h"
+
+class Database;
+
+// Выполняет операции с базой в отдельном потоке со своим соединением,
+// чтобы окно не зависало на fsync SQLite. Операции выполняются строго
+// по очереди, результат возвращается через QFuture.
+//
+// Отрицательный id (кроме -1) считается временным: его можно назначить
+// тренировке до записи и сразу использовать в updateWorkout/deleteWorkout,
+// поток записи сам подставит настоящий id после вставки.
+class DatabaseWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DatabaseWriter(QObject *parent = nullptr);
+    ~DatabaseWriter();
+
+    // Возвращает id, назначенный SQLite, или -1 при ошибке
+    QFuture<int> addWorkout(const WorkoutData &workout);
+    QFuture<bool> updateWorkout(const WorkoutData &workout);
+    QFuture<bool> deleteWorkout(int id);
+    QFuture<QVector<WorkoutData>> getAllWorkouts();
+
+    // Завершается, когда выполнены все поставленные ранее операции
+    QFuture<bool> sync();
+
+signals:
+    void error(const QString &message);
+
+private:
+    template <typename T, typename Function>
+    QFuture<T> enqueue(Function function);
+
+    // Вызываются только в потоке записи
+    Database *connection();
+    int resolveId(int id) const;
+
+    QThread workerThread;
+    QObject *context;
+    Database *database = nullptr;
+    QHash<int, int> provisionalIds;
+};
+
+#endif // DATABASEWRITER_H
@@ -1,10 +1,11 @@
 #include "mainwindow.h"
-#include <QtCharts>
+#include "theme.h"
 #include <QApplication>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+    Theme::apply(a);
     MainWindow w;
     w.show();
     return a.exec();
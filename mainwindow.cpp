@@ -1,19 +1,25 @@
 #include "mainwindow.h"
 #include "database.h"
+#include "databasewriter.h"
 #include "workoutdialog.h"
 #include "statsdialog.h"
+#include "csvimporter.h"
+#include "workoutrepository.h"
+#include "workoutlistmodel.h"
+#include "workoutcarddelegate.h"
+#include "theme.h"
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QLocale>
 #include <QMessageBox>
-#include <QGroupBox>
-#include <QScrollArea>
 #include <QFormLayout>
 #include <QMenu>
 #include <QAction>
 #include <QFile>
-#include <QTableWidget>
-#include <QHeaderView>
+#include <QFileDialog>
+#include <QProgressDialog>
+#include <QStatusBar>
+#include <QFuture>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), m_currentDate(QDate::currentDate())
@@ -27,9 +33,6 @@ MainWindow::MainWindow(QWidget *parent)
         QMessageBox::critical(this, "Ошибка", "Не удалось открыть базу данных");
     }
 
-    // Загрузка данных из базы
-    workouts = database->getAllWorkouts();
-
     // Проверка файла БД
         QFile dbFile("workout_tracker.db");
         if (!dbFile.exists()) {
@@ -45,12 +48,53 @@ MainWindow::MainWindow(QWidget *parent)
                 .arg(database->lastError()));
         }
 
+    // Запись в базу выполняется в отдельном потоке
+    writer = new DatabaseWriter(this);
+    connect(writer, &DatabaseWriter::error, this, &MainWindow::reportError);
+
+    // Тренировки в памяти и суммы для статистики
+    repository = new WorkoutRepository(database, writer, this);
+
+    // Загрузка из базы только видимой недели
+    ensureWeekLoaded();
+
     setupUI();
     updateWorkoutsDisplay();
 
+    // Список дня меняется только при изменении тренировок этого дня
+    connect(repository, &WorkoutRepository::workoutAdded, this,
+            [this](int id, const QDate &date, const QString &) {
+        if (date == m_currentDate) workoutsModel->addWorkout(repository->workout(id));
+    });
+    connect(repository, &WorkoutRepository::workoutUpdated, this,
+            [this](int id, const QDate &date, const QString &) {
+        if (date != m_currentDate || !workoutsModel->updateWorkout(repository->workout(id))) return;
+
+        // dataChanged не пересчитывает высоту строки, а у раскрытой
+        // карточки она зависит от текста заметок
+        const QModelIndex changed = workoutsModel->index(workoutsModel->rowOf(id));
+        if (changed.data(WorkoutListModel::ExpandedRole).toBool()) {
+            workoutsView->doItemsLayout();
+        }
+    });
+    connect(repository, &WorkoutRepository::workoutRemoved, this,
+            [this](int id, const QDate &date, const QString &) {
+        if (date == m_currentDate) workoutsModel->removeWorkout(id);
+    });
+    connect(repository, &WorkoutRepository::idChanged, this, [this](int provisionalId, int id) {
+        workoutsModel->changeId(provisionalId, id);
+        statusBar()->showMessage("Тренировка добавлена", 3000);
+    });
+    connect(repository, &WorkoutRepository::reset, this, &MainWindow::updateWorkoutsDisplay);
+
+    // Диалог тренировки строится один раз и переиспользуется
+    workoutDialog = new WorkoutDialog(this);
+
 }
 
-MainWindow::~MainWindow() {}
+MainWindow::~MainWindow()
+{
+}
 
 void MainWindow::resizeEvent(QResizeEvent *event)
 {
@@ -86,29 +130,13 @@ void MainWindow::setupUI()
     calendarButton->setIcon(QIcon(":/icons/calendar.png"));
     calendarButton->setIconSize(QSize(24, 24));
     calendarButton->setFlat(true);
-    calendarButton->setStyleSheet(
-        "QPushButton {"
-        "   border: none;"
-        "   padding: 5px;"
-        "   background: transparent;"
-        "}"
-        "QPushButton:hover {"
-        "   background: #e0e0e0;"
-        "   border-radius: 4px;"
-        "}"
-    );
+    calendarButton->setObjectName("calendarButton");
 
     // Метка для отображения текущего месяца и года
     currentDateLabel = new QLabel(this);
     currentDateLabel->setText(QLocale(QLocale::Russian).monthName(m_currentDate.month()) +
                          " " + QString::number(m_currentDate.year()));
-    currentDateLabel->setStyleSheet(
-        "QLabel {"
-        "   font-size: 16px;"
-        "   font-weight: bold;"
-        "   padding: 5px;"
-        "}"
-    );
+    currentDateLabel->setObjectName("currentDateLabel");
 
     dateControlsLayout->addWidget(calendarButton);
     dateControlsLayout->addWidget(currentDateLabel);
@@ -123,36 +151,14 @@ void MainWindow::setupUI()
 
     QPushButton *prevBtn = new QPushButton("◀", this);
     prevBtn->setFixedSize(30, 40);
-    prevBtn->setStyleSheet(
-        "QPushButton {"
-        "   font-size: 14px;"
-        "   border: none;"
-        "   background: transparent;"
-        "   padding: 0;"
-        "   margin: 0;"
-        "}"
-        "QPushButton:hover {"
-        "   background: #e0e0e0;"
-        "}"
-    );
+    Theme::setVariant(prevBtn, "weekNav");
 
     setupCalendar();
     m_daysList->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 
     QPushButton *nextBtn = new QPushButton("▶", this);
     nextBtn->setFixedSize(30, 40);
-    nextBtn->setStyleSheet(
-        "QPushButton {"
-        "   font-size: 14px;"
-        "   border: none;"
-        "   background: transparent;"
-        "   padding: 0;"
-        "   margin: 0;"
-        "}"
-        "QPushButton:hover {"
-        "   background: #e0e0e0;"
-        "}"
-    );
+    Theme::setVariant(nextBtn, "weekNav");
 
     weekNavLayout->addWidget(prevBtn);
     weekNavLayout->addWidget(m_daysList, 1);
@@ -160,50 +166,60 @@ void MainWindow::setupUI()
 
     workoutsPageLayout->addLayout(weekNavLayout);
 
-    // Контейнер для тренировок
-    workoutsContainer = new QWidget();
-    workoutsLayout = new QVBoxLayout(workoutsContainer);
-    workoutsLayout->setAlignment(Qt::AlignTop);
-    workoutsLayout->setSpacing(10);
-    workoutsLayout->setContentsMargins(0, 0, 0, 0);
-
-    QScrollArea *scrollArea = new QScrollArea();
-    scrollArea->setWidgetResizable(true);
-    scrollArea->setWidget(workoutsContainer);
-    scrollArea->setStyleSheet(
-        "QScrollArea {"
-        "   border: none;"
-        "   background: transparent;"
-        "}"
-        "QScrollArea > QWidget > QWidget {"
-        "   background: transparent;"
-        "}"
-    );
-    workoutsPageLayout->addWidget(scrollArea);
+    // Список тренировок дня: карточки рисует делегат,
+    // отдельные виджеты для них не создаются
+    workoutsModel = new WorkoutListModel(this);
+    workoutsModel->setNotesLoader([this](int id) {
+        return repository->notes(id);
+    });
+
+    workoutsView = new QListView();
+    workoutsView->setModel(workoutsModel);
+    workoutsView->setItemDelegate(new WorkoutCardDelegate(workoutsView));
+    workoutsView->setSelectionMode(QAbstractItemView::NoSelection);
+    workoutsView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    workoutsView->setResizeMode(QListView::Adjust);
+    workoutsView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    workoutsView->setContextMenuPolicy(Qt::CustomContextMenu);
+    workoutsView->setObjectName("workoutsView");
+    connect(workoutsView, &QListView::customContextMenuRequested,
+            this, &MainWindow::showWorkoutContextMenu);
+
+    noWorkoutsLabel = new QLabel("Нет тренировок на выбранную дату");
+    noWorkoutsLabel->setAlignment(Qt::AlignHCenter | Qt::AlignTop);
+    noWorkoutsLabel->setObjectName("noWorkoutsLabel");
+
+    // Пустое состояние следует за числом строк модели
+    auto updateEmptyState = [this]() {
+        const bool empty = workoutsModel->rowCount() == 0;
+        noWorkoutsLabel->setVisible(empty);
+        workoutsView->setVisible(!empty);
+    };
+    connect(workoutsModel, &QAbstractItemModel::rowsInserted, this, updateEmptyState);
+    connect(workoutsModel, &QAbstractItemModel::rowsRemoved, this, updateEmptyState);
+    connect(workoutsModel, &QAbstractItemModel::modelReset, this, updateEmptyState);
+
+    workoutsPageLayout->addWidget(noWorkoutsLabel);
+    workoutsPageLayout->addWidget(workoutsView, 1);
 
     // Кнопка добавления тренировки
     addButton = new QPushButton("Добавить тренировку", this);
-    addButton->setStyleSheet(
-        "QPushButton {"
-        "   background-color: #4CAF50;"
-        "   color: white;"
-        "   border: none;"
-        "   padding: 10px;"
-        "   border-radius: 4px;"
-        "   font-weight: bold;"
-        "}"
-        "QPushButton:hover {"
-        "   background-color: #45a049;"
-        "}"
-    );
-    workoutsPageLayout->addWidget(addButton);
-
-    // 2. Страница статистики
+    addButton->setObjectName("addButton");
+
+    // Кнопка импорта истории из CSV
+    importButton = new QPushButton("Импорт CSV", this);
+    importButton->setObjectName("importButton");
+
+    QHBoxLayout *actionsLayout = new QHBoxLayout();
+    actionsLayout->setContentsMargins(0, 0, 0, 0);
+    actionsLayout->addWidget(addButton, 1);
+    actionsLayout->addWidget(importButton);
+    workoutsPageLayout->addLayout(actionsLayout);
+
+    // 2. Страница статистики: содержимое создаётся при первом открытии
     statsPage = new QWidget();
     QVBoxLayout *statsPageLayout = new QVBoxLayout(statsPage);
     statsPageLayout->setContentsMargins(0, 0, 0, 0);
-    statsDialog = new StatsDialog(QVector<WorkoutData>(), this);
-    statsPageLayout->addWidget(statsDialog);
 
     // Добавляем страницы
     stackedWidget->addWidget(workoutsPage);
@@ -218,25 +234,9 @@ void MainWindow::setupUI()
     statsPageButton = new QPushButton("Статистика", this);
     workoutsButton->setEnabled(false);
 
-    // Стиль для кнопок навигации
-    QString navButtonStyle =
-        "QPushButton {"
-        "   padding: 8px 16px;"
-        "   border: none;"
-        "   background-color: #f0f0f0;"
-        "   font-size: 14px;"
-        "}"
-        "QPushButton:disabled {"
-        "   background-color: #ddd;"
-        "   font-weight: bold;"
-        "   border-top: 2px solid #4CAF50;"
-        "}"
-        "QPushButton:hover {"
-        "   background-color: #e0e0e0;"
-        "}";
-
-    workoutsButton->setStyleSheet(navButtonStyle);
-    statsPageButton->setStyleSheet(navButtonStyle);
+    // Оформление кнопок навигации - в theme.qss
+    Theme::setVariant(workoutsButton, "pageNav");
+    Theme::setVariant(statsPageButton, "pageNav");
 
     pageNavLayout->addWidget(workoutsButton);
     pageNavLayout->addWidget(statsPageButton);
@@ -246,6 +246,7 @@ void MainWindow::setupUI()
 
 
     connect(addButton, &QPushButton::clicked, this, &MainWindow::addWorkout);
+    connect(importButton, &QPushButton::clicked, this, &MainWindow::importWorkouts);
     connect(workoutsButton, &QPushButton::clicked, this, &MainWindow::showWorkoutsPage);
     connect(statsPageButton, &QPushButton::clicked, this, &MainWindow::showStatsPage);
     connect(prevBtn, &QPushButton::clicked, this, &MainWindow::prevWeek);
@@ -265,11 +266,33 @@ void MainWindow::showWorkoutsPage()
 }
 
 void MainWindow::showStatsPage() {
-    if (!statsDialog) {
-        statsDialog = new StatsDialog(workouts, this);
-    } else {
-        statsDialog->updateData(workouts);
-    }
+    // Статистика читается из сводных таблиц, поэтому сначала
+    // дожидаемся записи всех изменений из потока базы
+    writer->sync().then(this, [this](bool) {
+        const QDate today = QDate::currentDate();
+        if (!statsDialog) {
+            statsDialog = new StatsDialog(database, repository->rangeIndex(), this);
+            statsPage->layout()->addWidget(statsDialog);
+
+            // Сбрасываем только периоды, в которые попадает изменённая тренировка
+            auto invalidate = [this](int, const QDate &date, const QString &type) {
+                statsDialog->invalidate(type, date);
+            };
+            connect(repository, &WorkoutRepository::workoutAdded, statsDialog, invalidate);
+            connect(repository, &WorkoutRepository::workoutRemoved, statsDialog, invalidate);
+            connect(repository, &WorkoutRepository::workoutUpdated, statsDialog,
+                    [this](int, const QDate &date, const QString &type, const QString &previousType) {
+                statsDialog->invalidate(type, date);
+                if (previousType != type) statsDialog->invalidate(previousType, date);
+            });
+            connect(repository, &WorkoutRepository::reset, statsDialog, &StatsDialog::invalidateAll);
+        } else if (m_statsRevision != repository->revision() || m_statsShownOn != today) {
+            // Перестраиваем только если данные или текущий день изменились
+            statsDialog->refresh();
+        }
+        m_statsRevision = repository->revision();
+        m_statsShownOn = today;
+    });
     stackedWidget->setCurrentWidget(statsPage);
     workoutsButton->setEnabled(true);
     statsPageButton->setEnabled(false);
@@ -285,36 +308,7 @@ void MainWindow::setupCalendar()
     m_daysList->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
     m_daysList->setFixedHeight(60);
 
-    // Обновленный стиль
-    m_daysList->setStyleSheet(
-        "QListWidget {"
-        "   border: 1px solid #e0e0e0;"
-        "   background: white;"
-        "   outline: 0;"
-        "}"
-        "QListWidget::item {"
-        "   border: 1px solid transparent;"
-        "   padding: 2px;"
-        "   margin: 1px;"
-        "   text-align: center;"
-        "   border-radius: 5px;"
-        "}"
-        "QListWidget::item:hover {"
-        "   background: #f5f5f5;"
-        "   border: 1px solid #e0e0e0;"
-        "}"
-        "QListWidget::item:selected {"
-        "   background: #4CAF50;"
-        "   color: white;"
-        "   font-weight: bold;"
-        "   border: none;"
-        "}"
-        "QListWidget::item[background=\"today\"] {"
-        "   background: #E8F5E9;"
-        "   color: #2E7D32;"
-        "   border: 1px solid #A5D6A7;"
-        "}"
-    );
+    m_daysList->setObjectName("daysList");
 
     connect(m_daysList, &QListWidget::itemClicked, this, &MainWindow::daySelected);
 }
@@ -376,18 +370,29 @@ void MainWindow::daySelected(QListWidgetItem* item)
 void MainWindow::prevWeek()
 {
     m_currentDate = m_currentDate.addDays(-7);
+    ensureWeekLoaded();
     updateDays();
+    updateWorkoutsDisplay();
 }
 
 void MainWindow::nextWeek()
 {
     m_currentDate = m_currentDate.addDays(7);
+    ensureWeekLoaded();
     updateDays();
+    updateWorkoutsDisplay();
+}
+
+void MainWindow::ensureWeekLoaded()
+{
+    QDate weekStart = m_currentDate.addDays(-(m_currentDate.dayOfWeek() - 1));
+    repository->ensureLoaded(weekStart, weekStart.addDays(6));
 }
 
 void MainWindow::addWorkout()
 {
-    WorkoutDialog dialog(this);
+    WorkoutDialog &dialog = *workoutDialog;
+    dialog.reset();
     if (dialog.exec() == QDialog::Accepted) {
         WorkoutData workout;
         workout.type = dialog.getWorkoutType();
@@ -402,194 +407,72 @@ void MainWindow::addWorkout()
         workout.notes = dialog.getNotes();
         workout.date = m_currentDate;
 
-        if (!database->openDatabase()) {
-            QMessageBox::critical(this, "Ошибка", "Не удалось открыть базу данных");
-            return;
-        }
-
-        if (database->addWorkout(workout)) {
-            workouts.append(workout);
-            updateWorkoutsDisplay();
-            QMessageBox::information(this, "Успех", "Тренировка добавлена!");
-        } else {
-            QMessageBox::critical(this, "Ошибка",
-                QString("Не удалось добавить тренировку в базу данных.\nОшибка: %1")
-                .arg(database->lastError()));
-        }
+        // Карточка появится по сигналу хранилища
+        repository->add(workout);
     }
 }
 
-void MainWindow::showStats()
+void MainWindow::importWorkouts()
 {
-    StatsDialog statsDialog(workouts, this);
-    statsDialog.exec();
-}
+    QString fileName = QFileDialog::getOpenFileName(this, "Импорт тренировок", QString(),
+                                                    "CSV (*.csv);;Все файлы (*)");
+    if (fileName.isEmpty()) return;
 
-void MainWindow::toggleWorkoutDetails()
-{
-    QPushButton *button = qobject_cast<QPushButton*>(sender());
-    if (!button) return;
+    CsvImporter importer(database);
 
-    QWidget *detailsWidget = button->property("detailsWidget").value<QWidget*>();
-    if (!detailsWidget) return;
+    QProgressDialog progressDialog("Импорт тренировок...", "Отменить", 0, 100, this);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(500);
 
-    detailsWidget->setVisible(!detailsWidget->isVisible());
-    button->setText(detailsWidget->isVisible() ? "▲" : "▼");
-}
+    connect(&importer, &CsvImporter::progress, &progressDialog,
+            [&progressDialog](int rowsImported, qint64 bytesRead, qint64 totalBytes) {
+        progressDialog.setLabelText(QString("Импортировано тренировок: %1").arg(rowsImported));
+        if (totalBytes > 0) {
+            progressDialog.setValue(int(bytesRead * 100 / totalBytes));
+        }
+    });
+    connect(&progressDialog, &QProgressDialog::canceled, &importer, &CsvImporter::cancel);
 
-void MainWindow::updateWorkoutsDisplay()
-{
-    // Очищаем текущий layout
-    QLayoutItem *item;
-    while ((item = workoutsLayout->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
-    }
+    bool ok = importer.import(fileName);
+    progressDialog.reset();
 
-    // Фильтруем тренировки по текущей дате
-    QVector<WorkoutData> todayWorkouts;
-    for (const WorkoutData &workout : workouts) {
-        if (workout.date == m_currentDate) {
-            todayWorkouts.append(workout);
-        }
-    }
+    // Список дня и статистика перечитываются по сигналу reset
+    repository->addImported(importer.importedWorkouts());
 
-    if (todayWorkouts.isEmpty()) {
-        QLabel *noWorkoutsLabel = new QLabel("Нет тренировок на выбранную дату");
-        noWorkoutsLabel->setAlignment(Qt::AlignCenter);
-        noWorkoutsLabel->setStyleSheet("font-size: 14px; color: #666; margin-top: 20px;");
-        workoutsLayout->addWidget(noWorkoutsLabel);
+    if (!ok) {
+        QMessageBox::critical(this, "Ошибка",
+            QString("Импорт прерван. Добавлено тренировок: %1.\nОшибка: %2")
+            .arg(importer.importedCount())
+            .arg(importer.lastError()));
         return;
     }
 
-    for (const WorkoutData &workout : todayWorkouts) {
-        QGroupBox *workoutGroup = new QGroupBox();
-        workoutGroup->setContextMenuPolicy(Qt::CustomContextMenu);
-        connect(workoutGroup, &QGroupBox::customContextMenuRequested,
-                this, &MainWindow::showWorkoutContextMenu);
-
-        QVBoxLayout *groupLayout = new QVBoxLayout(workoutGroup);
-        groupLayout->setSpacing(0);
-
-        // Заголовок аккордеона
-        QWidget *headerWidget = new QWidget();
-        QHBoxLayout *headerLayout = new QHBoxLayout(headerWidget);
-        headerLayout->setContentsMargins(10, 5, 10, 5);
-
-        QLabel *titleLabel = new QLabel(workout.type);
-        titleLabel->setStyleSheet("font-weight: bold; font-size: 14px;");
-
-        QLabel *summaryLabel = new QLabel(QString("%1 мин · %2 подх.").arg(workout.duration).arg(workout.sets));
-        summaryLabel->setStyleSheet("color: #666;");
-
-        QPushButton *toggleButton = new QPushButton("▼");
-        toggleButton->setFixedSize(24, 24);
-        toggleButton->setStyleSheet(
-            "QPushButton {"
-            "   border: none;"
-            "   background: transparent;"
-            "   font-size: 12px;"
-            "}"
-        );
-
-        headerLayout->addWidget(titleLabel);
-        headerLayout->addWidget(summaryLabel);
-        headerLayout->addStretch();
-        headerLayout->addWidget(toggleButton);
-        headerWidget->setLayout(headerLayout);
-
-        // Создаем таблицу с деталями
-        QTableWidget *detailsTable = new QTableWidget();
-        detailsTable->setColumnCount(2);
-        detailsTable->setRowCount(4);
-        detailsTable->verticalHeader()->hide();
-        detailsTable->horizontalHeader()->hide();
-        detailsTable->setShowGrid(false);
-        detailsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
-        detailsTable->setSelectionMode(QAbstractItemView::NoSelection);
-
-        detailsTable->setStyleSheet(
-            "QTableWidget {"
-            "   background-color: #f0f0f0;"
-            "   border: 1px solid #c0c0c0;"
-            "   border-radius: 5px;"
-            "   margin: 5px;"
-            "   gridline-color: transparent;"
-            "}"
-            "QTableWidget QTableCornerButton::section {"
-            "   background: #e0e0e0;"
-            "   border: 1px solid #c0c0c0;"
-            "}"
-            "QTableWidget::item {"
-            "   padding: 5px 10px;"
-            "   border: none;"
-            "   background: transparent;"
-            "}"
-            "QTableWidget::item:selected {"
-            "   background: #d8d8d8;"
-            "}"
-        );
-
-
-        QPalette palette = detailsTable->palette();
-        palette.setColor(QPalette::Base, QColor(240, 240, 240));
-        palette.setColor(QPalette::Window, QColor(240, 240, 240));
-        detailsTable->setPalette(palette);
-
-
-        detailsTable->setAutoFillBackground(true);
-
-        // Заполнение таблицы данными
-        addTableRow(detailsTable, 0, "Длительность:", QString("%1 мин").arg(workout.duration));
-        addTableRow(detailsTable, 1, "Подходы:", QString::number(workout.sets));
-        addTableRow(detailsTable, 2, "Повторения:", QString::number(workout.reps));
-        addTableRow(detailsTable, 3, "Ккал:", QString::number(workout.calories));
-
-        // Настройка столбцов
-        detailsTable->setColumnWidth(0, 120);
-        detailsTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
-        detailsTable->setFixedHeight(detailsTable->rowHeight(0) * detailsTable->rowCount() + 12);
-
-        detailsTable->setVisible(false);
-
-        groupLayout->addWidget(headerWidget);
-        groupLayout->addWidget(detailsTable);
-
-        // Настройка кнопки аккордеона
-        toggleButton->setProperty("detailsWidget", QVariant::fromValue(detailsTable));
-        connect(toggleButton, &QPushButton::clicked, this, [this, toggleButton]() {
-            QWidget *detailsWidget = toggleButton->property("detailsWidget").value<QWidget*>();
-            if (!detailsWidget) return;
-
-            bool isVisible = detailsWidget->isVisible();
-            toggleButton->setText(isVisible ? "▼" : "▲");
-            detailsWidget->setVisible(!isVisible);
-        });
-
-        workoutsLayout->addWidget(workoutGroup);
-    }
+    QMessageBox::information(this, "Импорт",
+        QString("Добавлено тренировок: %1\nПропущено строк: %2")
+        .arg(importer.importedCount())
+        .arg(importer.skippedCount()));
 }
 
-void MainWindow::addTableRow(QTableWidget *table, int row, const QString &label, const QString &value)
+void MainWindow::showStats()
 {
-    QTableWidgetItem *labelItem = new QTableWidgetItem(label);
-    labelItem->setFlags(labelItem->flags() ^ Qt::ItemIsEditable);
-    labelItem->setForeground(QColor("#505050"));
-
-    QTableWidgetItem *valueItem = new QTableWidgetItem(value);
-    valueItem->setFlags(valueItem->flags() ^ Qt::ItemIsEditable);
-    valueItem->setForeground(Qt::black);
+    StatsDialog statsDialog(database, repository->rangeIndex(), this);
+    statsDialog.exec();
+}
 
-    table->setItem(row, 0, labelItem);
-    table->setItem(row, 1, valueItem);
+void MainWindow::updateWorkoutsDisplay()
+{
+    // Тренировки текущей даты берём из хранилища по ключу дня;
+    // смена дня - единственный случай полного сброса списка
+    workoutsModel->setWorkouts(repository->workoutsOn(m_currentDate));
 }
 
 void MainWindow::showWorkoutContextMenu(const QPoint &pos)
 {
-    QGroupBox *workoutBox = qobject_cast<QGroupBox*>(sender());
-    if (!workoutBox) return;
+    const QModelIndex index = workoutsView->indexAt(pos);
+    if (!index.isValid()) return;
 
-    contextMenuWorkout = workoutBox;
+    // Карточка привязана к id тренировки
+    contextMenuWorkoutId = workoutsModel->workoutId(index);
 
     QMenu contextMenu(this);
     QAction *editAction = contextMenu.addAction("Редактировать");
@@ -598,68 +481,49 @@ void MainWindow::showWorkoutContextMenu(const QPoint &pos)
     connect(editAction, &QAction::triggered, this, &MainWindow::editWorkout);
     connect(deleteAction, &QAction::triggered, this, &MainWindow::deleteWorkout);
 
-    contextMenu.exec(workoutBox->mapToGlobal(pos));
+    contextMenu.exec(workoutsView->viewport()->mapToGlobal(pos));
 }
 
 void MainWindow::deleteWorkout()
 {
-    if (!contextMenuWorkout) return;
+    const int id = repository->resolveId(contextMenuWorkoutId);
+    if (id == -1) return;
 
-    int index = findWorkoutIndex(contextMenuWorkout);
-    if (index >= 0) {
-        if (database->deleteWorkout(workouts[index].id)) {
-            workouts.removeAt(index);
-            updateWorkoutsDisplay();
-        } else {
-            QMessageBox::warning(this, "Ошибка", "Не удалось удалить тренировку из базы данных");
-        }
-    }
+    repository->remove(id);
 }
 
 void MainWindow::editWorkout()
 {
-    if (!contextMenuWorkout) return;
+    const int id = repository->resolveId(contextMenuWorkoutId);
+    if (id == -1) return;
 
-    int index = findWorkoutIndex(contextMenuWorkout);
-    if (index < 0) return;
+    // Заметки подгружаются из базы только здесь
+    const WorkoutData previous = repository->workout(id);
 
-    WorkoutDialog dialog(this, true);
-    dialog.setWorkoutData(workouts[index]);
+    WorkoutDialog &dialog = *workoutDialog;
+    dialog.reset(true);
+    dialog.setWorkoutData(previous);
 
     if (dialog.exec() == QDialog::Accepted) {
-        workouts[index].type = dialog.getWorkoutType();
-        if (workouts[index].type == "Другое") {
-            workouts[index].type = dialog.getCustomType();
-        }
-        workouts[index].duration = dialog.getDuration();
-        workouts[index].sets = dialog.getSets();
-        workouts[index].reps = dialog.getReps();
-        workouts[index].calories = dialog.getCalories();
-        workouts[index].notes = dialog.getNotes();
-
-        if (database->updateWorkout(workouts[index])) {
-            updateWorkoutsDisplay();
-        } else {
-            QMessageBox::warning(this, "Ошибка", "Не удалось обновить тренировку в базе данных");
+        WorkoutData workout = previous;
+        workout.type = dialog.getWorkoutType();
+        if (workout.type == "Другое") {
+            workout.type = dialog.getCustomType();
         }
+        workout.duration = dialog.getDuration();
+        workout.sets = dialog.getSets();
+        workout.reps = dialog.getReps();
+        workout.calories = dialog.getCalories();
+        workout.notes = dialog.getNotes();
+
+        repository->update(workout);
     }
 }
 
-int MainWindow::findWorkoutIndex(QGroupBox* workoutBox)
+void MainWindow::reportError(const QString &message)
 {
-    for (int i = 0; i < workoutsLayout->count(); ++i) {
-        if (workoutsLayout->itemAt(i)->widget() == workoutBox) {
-            QString workoutType = workoutBox->findChild<QLabel*>()->text();
-            QDate workoutDate = m_currentDate;
-
-            for (int j = 0; j < workouts.size(); ++j) {
-                if (workouts[j].type == workoutType && workouts[j].date == workoutDate) {
-                    return j;
-                }
-            }
-        }
-    }
-    return -1;
+    // Ошибки записи показываем без модального окна
+    statusBar()->showMessage(message, 5000);
 }
 
 void MainWindow::showCalendarDialog()
@@ -668,11 +532,7 @@ void MainWindow::showCalendarDialog()
     calendarDialog.setWindowTitle("Выберите дату");
     calendarDialog.setWindowFlags(calendarDialog.windowFlags() & ~Qt::WindowContextHelpButtonHint);
     calendarDialog.resize(400, 350);
-    calendarDialog.setStyleSheet(
-        "QDialog {"
-        "   background-color: white;"
-        "}"
-    );
+    calendarDialog.setObjectName("calendarDialog");
 
     QVBoxLayout *layout = new QVBoxLayout(&calendarDialog);
     layout->setContentsMargins(10, 10, 10, 10);
@@ -681,42 +541,6 @@ void MainWindow::showCalendarDialog()
     // Календарь
     QCalendarWidget *calendar = new QCalendarWidget(&calendarDialog);
     calendar->setSelectedDate(m_currentDate);
-    calendar->setStyleSheet(
-        "QCalendarWidget {"
-        "   background-color: white;"
-        "   border: none;"
-        "}"
-        "QCalendarWidget QWidget {"
-        "   background-color: white;"
-        "   alternate-background-color: white;"
-        "}"
-        "QCalendarWidget QToolButton {"
-        "   height: 30px;"
-        "   font-size: 14px;"
-        "   color: #333333;"
-        "   background-color: white;"
-        "   border: none;"
-        "}"
-        "QCalendarWidget QToolButton:hover {"
-        "   background-color: #f5f5f5;"
-        "   border-radius: 4px;"
-        "}"
-        "QCalendarWidget QMenu {"
-        "   width: 150px;"
-        "   left: 20px;"
-        "   background-color: white;"
-        "   border: 1px solid #e0e0e0;"
-        "}"
-        "QCalendarWidget QSpinBox {"
-        "   padding: 2px;"
-        "   background-color: white;"
-        "   border: 1px solid #e0e0e0;"
-        "   border-radius: 4px;"
-        "   min-width: 80px;"
-        "   selection-background-color: #4CAF50;"
-        "   selection-color: white;"
-        "}"
-    );
 
 
     calendar->setVerticalHeaderFormat(QCalendarWidget::NoVerticalHeader);
@@ -774,35 +598,9 @@ void MainWindow::showCalendarDialog()
     QPushButton *cancelButton = new QPushButton("Отменить", &calendarDialog);
     QPushButton *okButton = new QPushButton("OK", &calendarDialog);
 
-    cancelButton->setStyleSheet(
-        "QPushButton {"
-        "   padding: 6px 12px;"
-        "   border-radius: 4px;"
-        "   font-size: 12px;"
-        "   background-color: #f44336;"
-        "   color: white;"
-        "   border: none;"
-        "   min-width: 70px;"
-        "}"
-        "QPushButton:hover {"
-        "   background-color: #d32f2f;"
-        "}"
-    );
-
-    okButton->setStyleSheet(
-        "QPushButton {"
-        "   padding: 6px 12px;"
-        "   border-radius: 4px;"
-        "   font-size: 12px;"
-        "   background-color: #4CAF50;"
-        "   color: white;"
-        "   border: none;"
-        "   min-width: 70px;"
-        "}"
-        "QPushButton:hover {"
-        "   background-color: #45a049;"
-        "}"
-    );
+    cancelButton->setObjectName("calendarCancelButton");
+
+    okButton->setObjectName("calendarOkButton");
 
     buttonLayout->addWidget(cancelButton);
     buttonLayout->addStretch();
@@ -832,6 +630,7 @@ void MainWindow::showCalendarDialog()
             QLocale(QLocale::Russian).monthName(m_currentDate.month()) +
             " " + QString::number(m_currentDate.year())
         );
+        ensureWeekLoaded();
         updateDays();
         updateWorkoutsDisplay();
     }
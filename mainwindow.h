@@ -3,22 +3,25 @@
 
 #include <QMainWindow>
 #include <QListWidget>
+#include <QListView>
 #include <QComboBox>
 #include <QLabel>
 #include <QDate>
 #include <QHBoxLayout>
 #include <QPushButton>
 #include <QVector>
-#include <QGroupBox>
+#include <QHash>
 #include <QFormLayout>
 #include <QMenu>
 #include <QAction>
 #include <QStackedWidget>
-#include <QTableWidget>
 #include <QCalendarWidget>
 #include <QDialogButtonBox>
 
 class Database;
+class DatabaseWriter;
+class WorkoutRepository;
+class WorkoutListModel;
 
 struct WorkoutData {
     int id = -1;
@@ -32,6 +35,7 @@ struct WorkoutData {
 };
 
 class StatsDialog;
+class WorkoutDialog;
 
 class MainWindow : public QMainWindow
 {
@@ -48,39 +52,46 @@ private slots:
     void prevWeek();
     void nextWeek();
     void addWorkout();
-    void toggleWorkoutDetails();
+    void importWorkouts();
     void showWorkoutContextMenu(const QPoint &pos);
     void deleteWorkout();
     void editWorkout();
     void showStats();
     void showWorkoutsPage();
     void showStatsPage();
-    void addTableRow(QTableWidget *table, int row, const QString &label, const QString &value);
 
 private:
     QLabel *currentDateLabel;
     Database *database;
+    DatabaseWriter *writer;
     void setupUI();
     void setupCalendar();
     void updateWorkoutsDisplay();
-    int findWorkoutIndex(QGroupBox* workoutBox);
+    void ensureWeekLoaded();
+    void reportError(const QString &message);
 
     QDate m_currentDate;
     QListWidget* m_daysList;
     QComboBox* m_monthCombo;
     QComboBox* m_yearCombo;
     QPushButton *addButton;
-    QWidget *workoutsContainer;
-    QVBoxLayout *workoutsLayout;
-    QVector<WorkoutData> workouts;
-    QGroupBox* contextMenuWorkout;
+    QPushButton *importButton;
+    QListView *workoutsView;
+    WorkoutListModel *workoutsModel;
+    QLabel *noWorkoutsLabel;
+    WorkoutRepository *repository;
+    int contextMenuWorkoutId = -1;
     QPushButton *statsButton;
     QStackedWidget *stackedWidget;
     QWidget *workoutsPage;
     QWidget *statsPage;
     QPushButton *workoutsButton;
     QPushButton *statsPageButton;
-    StatsDialog *statsDialog;
+    StatsDialog *statsDialog = nullptr;
+    // Ревизия данных, показанная на странице статистики
+    quint64 m_statsRevision = 0;
+    QDate m_statsShownOn;
+    WorkoutDialog *workoutDialog;
 
 protected:
     void resizeEvent(QResizeEvent *event) override;
@@ -0,0 +1,193 @@
+#include "rangeindex.h"
+
+// Запас дней при расширении дерева, чтобы новые даты не вызывали
+// перестроение на каждую тренировку
+static const int GrowMargin = 366;
+
+static RangeTotals prefix(const QVector<RangeTotals> &nodes, int position)
+{
+    RangeTotals result;
+    for (int i = position; i > 0; i -= i & -i) {
+        result += nodes[i];
+    }
+    return result;
+}
+
+static RangeTotals rangeTotal(int firstDay, const QVector<RangeTotals> &nodes,
+                              const QDate &from, const QDate &to)
+{
+    if (nodes.size() < 2) return {};
+
+    const int size = nodes.size() - 1;
+    const int first = qMax(int(from.toJulianDay()) - firstDay + 1, 1);
+    const int last = qMin(int(to.toJulianDay()) - firstDay + 1, size);
+    if (first > last) return {};
+
+    RangeTotals result = prefix(nodes, last);
+    result -= prefix(nodes, first - 1);
+    return result;
+}
+
+RangeTotals &RangeTotals::operator+=(const RangeTotals &other)
+{
+    count += other.count;
+    duration += other.duration;
+    calories += other.calories;
+    return *this;
+}
+
+RangeTotals &RangeTotals::operator-=(const RangeTotals &other)
+{
+    count -= other.count;
+    duration -= other.duration;
+    calories -= other.calories;
+    return *this;
+}
+
+quint64 RangeSnapshot::revision() const
+{
+    return m_revision;
+}
+
+RangeTotals RangeSnapshot::total(const QDate &from, const QDate &to) const
+{
+    return rangeTotal(m_firstDay, m_nodes, from, to);
+}
+
+void RangeIndex::setLoader(const Loader &loader)
+{
+    m_loader = loader;
+    m_trees.clear();
+}
+
+void RangeIndex::clear()
+{
+    m_trees.clear();
+}
+
+void RangeIndex::insert(const WorkoutData &workout)
+{
+    apply(workout.type, workout.date, {1, workout.duration, workout.calories});
+}
+
+void RangeIndex::remove(const WorkoutData &workout)
+{
+    apply(workout.type, workout.date, {-1, -qint64(workout.duration), -qint64(workout.calories)});
+}
+
+RangeSnapshotPtr RangeIndex::snapshot(const QString &type) const
+{
+    const Tree *found = tree(type);
+    if (!found) return QSharedPointer<RangeSnapshot>::create();
+
+    // Пока дерево не менялось, все читатели получают один и тот же снимок
+    if (!found->published) {
+        QSharedPointer<RangeSnapshot> created = QSharedPointer<RangeSnapshot>::create();
+        created->m_firstDay = found->firstDay;
+        created->m_nodes = found->nodes;
+        created->m_revision = found->revision;
+        found->published = created;
+    }
+    return found->published;
+}
+
+quint64 RangeIndex::revision(const QString &type) const
+{
+    auto it = m_trees.constFind(type);
+    return it != m_trees.cend() ? it.value().revision : 0;
+}
+
+const RangeIndex::Tree *RangeIndex::tree(const QString &type) const
+{
+    auto it = m_trees.constFind(type);
+    if (it != m_trees.cend()) return &it.value();
+    if (!m_loader) return nullptr;
+
+    const QVector<RollupRow> rows = m_loader(type);
+
+    Tree &loaded = m_trees[type];
+    loaded.revision = ++m_revision;
+    if (rows.isEmpty()) return &loaded;
+
+    // Строки сводки упорядочены по дню
+    loaded.firstDay = int(rows.first().period.toJulianDay());
+    const int lastDay = int(rows.last().period.toJulianDay());
+
+    QVector<RangeTotals> dayTotals(lastDay - loaded.firstDay + 1 + GrowMargin);
+    for (const RollupRow &row : rows) {
+        dayTotals[int(row.period.toJulianDay()) - loaded.firstDay] = {row.count, row.duration, row.calories};
+    }
+    build(loaded, std::move(dayTotals));
+    return &loaded;
+}
+
+void RangeIndex::apply(const QString &type, const QDate &date, const RangeTotals &delta)
+{
+    auto it = m_trees.find(type);
+    if (it == m_trees.end() || !date.isValid()) return;
+
+    Tree &found = it.value();
+    found.revision = ++m_revision;
+    // Отпускаем свой снимок до изменения: если его уже никто
+    // не читает, узлы не придётся копировать
+    found.published.reset();
+
+    const int day = int(date.toJulianDay());
+    grow(found, day);
+
+    // Точечное изменение: O(log n) узлов
+    const int size = found.nodes.size() - 1;
+    for (int i = day - found.firstDay + 1; i <= size; i += i & -i) {
+        found.nodes[i] += delta;
+    }
+}
+
+void RangeIndex::grow(Tree &tree, int day)
+{
+    const int size = tree.nodes.size() - 1;
+    if (size > 0 && day >= tree.firstDay && day < tree.firstDay + size) return;
+
+    QVector<RangeTotals> dayTotals = points(tree);
+    if (size <= 0) {
+        tree.firstDay = day;
+        dayTotals.resize(1 + GrowMargin);
+    } else if (day < tree.firstDay) {
+        const int shift = tree.firstDay - day + GrowMargin;
+        dayTotals.insert(0, shift, RangeTotals());
+        tree.firstDay -= shift;
+    } else {
+        dayTotals.resize(day - tree.firstDay + 1 + GrowMargin);
+    }
+    build(tree, std::move(dayTotals));
+}
+
+void RangeIndex::build(Tree &tree, QVector<RangeTotals> &&points)
+{
+    // Построение за O(n): каждый узел добавляется в родителя
+    const int size = points.size();
+    tree.nodes = std::move(points);
+    tree.nodes.prepend(RangeTotals());
+    for (int i = 1; i <= size; ++i) {
+        const int parent = i + (i & -i);
+        if (parent <= size) {
+            tree.nodes[parent] += tree.nodes[i];
+        }
+    }
+}
+
+QVector<RangeTotals> RangeIndex::points(const Tree &tree)
+{
+    // Обратное к build: восстанавливаем значения по дням
+    QVector<RangeTotals> result = tree.nodes;
+    const int size = result.size() - 1;
+    for (int i = size; i >= 1; --i) {
+        const int parent = i + (i & -i);
+        if (parent <= size) {
+            result[parent] -= result[i];
+        }
+    }
+    if (!result.isEmpty()) {
+        result.removeFirst();
+    }
+    return result;
+}
@@ -0,0 +1,89 @@
+#ifndef RANGEINDEX_H
+#define RANGEINDEX_H
+
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QDate>
+#include <QSharedPointer>
+#include <functional>
+#include "database.h"
+#include "mainwindow.h"
+
+struct RangeTotals {
+    int count = 0;
+    qint64 duration = 0;
+    qint64 calories = 0;
+
+    RangeTotals &operator+=(const RangeTotals &other);
+    RangeTotals &operator-=(const RangeTotals &other);
+};
+
+// Неизменяемый снимок дерева одного вида спорта для чтения в другом
+// потоке. revision - номер изменения дерева, по которому построен снимок;
+// результат по снимку актуален, пока он равен RangeIndex::revision(type).
+class RangeSnapshot
+{
+public:
+    quint64 revision() const;
+
+    // Границы включительно
+    RangeTotals total(const QDate &from, const QDate &to) const;
+
+private:
+    friend class RangeIndex;
+
+    int m_firstDay = 0;
+    QVector<RangeTotals> m_nodes;
+    quint64 m_revision = 0;
+};
+
+using RangeSnapshotPtr = QSharedPointer<const RangeSnapshot>;
+
+// Суммы по произвольному диапазону дат за O(log n): для каждого вида
+// спорта дерево Фенвика по номерам дней (количество, минуты, ккал).
+//
+// Дерево вида спорта строится при первом запросе из дневной сводки,
+// которую возвращает загрузчик. Изменения тренировок применяются
+// точечно; для ещё не загруженного вида спорта они пропускаются,
+// так как он будет прочитан из базы целиком.
+class RangeIndex
+{
+public:
+    using Loader = std::function<QVector<RollupRow>(const QString &type)>;
+
+    void setLoader(const Loader &loader);
+    void clear();
+
+    void insert(const WorkoutData &workout);
+    void remove(const WorkoutData &workout);
+
+    // Снимок создаётся один раз на изменение дерева и общий для всех
+    // читателей; узлы разделяются с деревом без копирования.
+    RangeSnapshotPtr snapshot(const QString &type) const;
+
+    // Номер последнего изменения дерева вида спорта; 0 - дерево не загружено.
+    // Номера не повторяются и после clear()
+    quint64 revision(const QString &type) const;
+
+private:
+    struct Tree {
+        int firstDay = 0;               // день в позиции 1
+        QVector<RangeTotals> nodes;     // nodes[0] не используется
+        quint64 revision = 0;           // см. revision()
+        mutable RangeSnapshotPtr published;     // сбрасывается при изменении
+    };
+
+    const Tree *tree(const QString &type) const;
+    void apply(const QString &type, const QDate &date, const RangeTotals &delta);
+    void grow(Tree &tree, int day);
+
+    static void build(Tree &tree, QVector<RangeTotals> &&points);
+    static QVector<RangeTotals> points(const Tree &tree);
+
+    Loader m_loader;
+    mutable QHash<QString, Tree> m_trees;
+    mutable quint64 m_revision = 0;
+};
+
+#endif // RANGEINDEX_H
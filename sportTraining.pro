@@ -1,7 +1,6 @@
 QT       += core gui
-QT       += charts
-QT += core gui charts
 QT += sql
+QT += concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -12,17 +11,39 @@ CONFIG += c++17
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    connectionprofile.cpp \
+    csvimporter.cpp \
     database.cpp \
+    databasewriter.cpp \
     main.cpp \
     mainwindow.cpp \
+    rangeindex.cpp \
     statsdialog.cpp \
-    workoutdialog.cpp
+    statsengine.cpp \
+    theme.cpp \
+    trendchartwidget.cpp \
+    workoutcarddelegate.cpp \
+    workoutdialog.cpp \
+    workoutlistmodel.cpp \
+    workoutrepository.cpp \
+    workoutstore.cpp
 
 HEADERS += \
+    connectionprofile.h \
+    csvimporter.h \
     database.h \
+    databasewriter.h \
     mainwindow.h \
+    rangeindex.h \
     statsdialog.h \
-    workoutdialog.h
+    statsengine.h \
+    theme.h \
+    trendchartwidget.h \
+    workoutcarddelegate.h \
+    workoutdialog.h \
+    workoutlistmodel.h \
+    workoutrepository.h \
+    workoutstore.h
 
 FORMS += \
     mainwindow.ui
@@ -33,4 +54,5 @@ else: unix:!android: target.path = /opt/$${TARGET}/bin
 !isEmpty(target.path): INSTALLS += target
 
 RESOURCES += \
-    icons.qrc
+    icons.qrc \
+    theme.qrc
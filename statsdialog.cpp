@@ -1,11 +1,11 @@
 #include "statsdialog.h"
-#include <QtCharts/QBarCategoryAxis>
-#include <QtCharts/QValueAxis>
-#include <QtCharts/QBarSeries>
-#include <QtCharts/QBarSet>
-#include <QtCharts/QChartView>
-#include <QtCharts/QLegend>
-#include <QtCharts/QLineSeries>
+#include "database.h"
+#include "statsengine.h"
+#include "rangeindex.h"
+#include "trendchartwidget.h"
+#include "theme.h"
+#include <QtConcurrent/QtConcurrentRun>
+#include <QFuture>
 #include <QLabel>
 #include <QScrollArea>
 #include <QVBoxLayout>
@@ -14,37 +14,55 @@
 #include <QDate>
 #include <QPen>
 #include <QScrollBar>
+#include <QSignalBlocker>
 #include <QVector>
 #include <algorithm>
 #include <limits>
 
-StatsDialog::StatsDialog(const QVector<WorkoutData>& workouts, QWidget *parent)
-    : QDialog(parent), allWorkouts(workouts), currentStartDate(QDate::currentDate()), currentEndDate(QDate::currentDate())
+// Сколько рассчитанных периодов держать в кэше
+static const int StatsCacheSize = 64;
+
+StatsDialog::StatsDialog(Database *database, RangeIndex *rangeIndex, QWidget *parent)
+    : QDialog(parent), database(database), rangeIndex(rangeIndex), currentStartDate(QDate::currentDate()), currentEndDate(QDate::currentDate())
 {
     setWindowTitle("Статистика тренировок");
     resize(1000, 700);
 
+    m_cache.setMaxCost(StatsCacheSize);
+
     currentLayout = new QVBoxLayout(this);
     currentLayout->setContentsMargins(0, 0, 0, 0);
 
     setupUI();
 }
 
-void StatsDialog::updateData(const QVector<WorkoutData>& workouts)
+void StatsDialog::refresh()
 {
-    allWorkouts = workouts;
-    setupUI();
+    setupCharts();
 }
 
-void StatsDialog::setupUI() {
-    QLayoutItem* child;
-    while ((child = currentLayout->takeAt(0)) != nullptr) {
-        if (child->widget()) {
-            child->widget()->deleteLater();
+void StatsDialog::invalidate(const QString &type, const QDate &date)
+{
+    const QDate today = QDate::currentDate();
+    const int day = int(date.toJulianDay());
+    const QList<StatsCacheKey> keys = m_cache.keys();
+    for (const StatsCacheKey &key : keys) {
+        if (key.sport != type) continue;
+
+        QDate startDate, endDate;
+        StatsEngine::periodRange(StatsPeriod(key.period), key.shift, today, startDate, endDate);
+        if (day >= startDate.toJulianDay() && day <= endDate.toJulianDay()) {
+            m_cache.remove(key);
         }
-        delete child;
     }
+}
 
+void StatsDialog::invalidateAll()
+{
+    m_cache.clear();
+}
+
+void StatsDialog::setupUI() {
     // Создаем элементы управления
     QWidget *controlsWidget = new QWidget();
     QHBoxLayout *controlsLayout = new QHBoxLayout(controlsWidget);
@@ -52,13 +70,13 @@ void StatsDialog::setupUI() {
 
     sportsCombo = new QComboBox(this);
     sportsCombo->setFixedWidth(200);
-    sportsCombo->setStyleSheet("QComboBox { font-size: 14px; }");
+    sportsCombo->setObjectName("sportsCombo");
 
     periodCombo = new QComboBox(this);
-    periodCombo->addItems({"Неделя", "Месяц", "Год"});
+    periodCombo->addItems({"Неделя", "Месяц", "Год", "90 дней"});
     periodCombo->setCurrentIndex(currentPeriod);
     periodCombo->setFixedWidth(150);
-    periodCombo->setStyleSheet("QComboBox { font-size: 14px; }");
+    periodCombo->setObjectName("periodCombo");
 
     // Кнопки навигации
     prevPeriodButton = new QPushButton("◀", this);
@@ -66,25 +84,13 @@ void StatsDialog::setupUI() {
     prevPeriodButton->setFixedSize(30, 30);
     nextPeriodButton->setFixedSize(30, 30);
 
-    QString buttonStyle = "QPushButton {"
-                         "   border: none;"
-                         "   background: #f0f0f0;"
-                         "   font-size: 14px;"
-                         "   border-radius: 4px;"
-                         "}"
-                         "QPushButton:hover {"
-                         "   background: #e0e0e0;"
-                         "}"
-                         "QPushButton:disabled {"
-                         "   color: #aaa;"
-                         "}";
-    prevPeriodButton->setStyleSheet(buttonStyle);
-    nextPeriodButton->setStyleSheet(buttonStyle);
+    Theme::setVariant(prevPeriodButton, "periodNav");
+    Theme::setVariant(nextPeriodButton, "periodNav");
 
     // Метка для отображения текущего периода
     QLabel *periodLabel = new QLabel(this);
     periodLabel->setAlignment(Qt::AlignCenter);
-    periodLabel->setStyleSheet("QLabel { font-weight: bold; }");
+    periodLabel->setObjectName("periodLabel");
 
     // Компоновка элементов управления
     controlsLayout->addWidget(prevPeriodButton);
@@ -108,7 +114,20 @@ void StatsDialog::setupUI() {
     chartsLayout->setContentsMargins(0, 0, 0, 0);
     chartsLayout->setSpacing(20);
 
-    setupCharts(allWorkouts, contentLayout);
+    // Метка периода и графики создаются один раз,
+    // при навигации меняются только данные
+    periodInfoLabel = new QLabel();
+    periodInfoLabel->setAlignment(Qt::AlignCenter);
+    periodInfoLabel->setObjectName("periodInfoLabel");
+    chartsLayout->addWidget(periodInfoLabel);
+
+    noDataLabel = new QLabel("Нет данных для отображения статистики");
+    noDataLabel->setAlignment(Qt::AlignCenter);
+    chartsLayout->addWidget(noDataLabel);
+
+    durationChart = createScrollableChart("Минуты", "мин", QColor("#4285F4"));
+    caloriesChart = createScrollableChart("Ккал", "ккал", QColor("#34A853"));
+    intensityChart = createScrollableChart("Ккал/мин", "ккал/мин", QColor("#EA4335"));
 
     contentLayout->addWidget(chartsContainer);
     scrollArea->setWidget(contentWidget);
@@ -125,6 +144,8 @@ void StatsDialog::setupUI() {
 
     // Обновляем кнопки навигации
     updateNavigationButtons();
+
+    setupCharts();
 }
 
 void StatsDialog::shiftPeriod(int direction)
@@ -140,52 +161,30 @@ void StatsDialog::updateNavigationButtons()
     nextPeriodButton->setEnabled(true);
 }
 
-void StatsDialog::setupCharts(const QVector<WorkoutData>& workouts, QVBoxLayout *layout)
+void StatsDialog::setupCharts()
 {
-    QLayoutItem* child;
-    while ((child = chartsLayout->takeAt(0)) != nullptr) {
-        if (child->widget()) {
-            delete child->widget();
-        }
-        delete child;
-    }
-
-    sportsCombo->clear();
-
-    if (workouts.isEmpty()) {
-        QLabel *noDataLabel = new QLabel("Нет данных для отображения статистики");
-        noDataLabel->setAlignment(Qt::AlignCenter);
-        chartsLayout->addWidget(noDataLabel);
-        return;
+    // Виды спорта берём из сводных таблиц, не читая всю историю
+    const QString currentSport = sportsCombo->currentText();
+    const QStringList sports = database->getWorkoutTypes();
+    {
+        const QSignalBlocker blocker(sportsCombo);
+        sportsCombo->clear();
+        sportsCombo->addItems(sports);
+        sportsCombo->setCurrentIndex(qMax(0, sports.indexOf(currentSport)));
     }
 
-    // Собираем уникальные виды спорта
-    QSet<QString> uniqueSports;
-    for (const WorkoutData &workout : workouts) {
-        if (!workout.type.isEmpty()) {
-            uniqueSports.insert(workout.type);
+    noDataLabel->setVisible(sports.isEmpty());
+    if (sports.isEmpty()) {
+        // Результат запроса, начатого до обновления, больше не нужен
+        ++m_generation;
+        periodInfoLabel->hide();
+        for (TrendChart *chart : {&durationChart, &caloriesChart, &intensityChart}) {
+            chart->container->hide();
         }
-    }
-
-    if (uniqueSports.isEmpty()) {
-        QLabel *noValidDataLabel = new QLabel("Нет валидных данных для статистики");
-        noValidDataLabel->setAlignment(Qt::AlignCenter);
-        chartsLayout->addWidget(noValidDataLabel);
         return;
     }
 
-    // Заполняем комбобокс видами спорта
-    sportsCombo->addItems(uniqueSports.values());
-
-    // Заголовок
-    QLabel *titleLabel = new QLabel("<h2>Статистика тренировок</h2>");
-    titleLabel->setTextFormat(Qt::RichText);
-    titleLabel->setAlignment(Qt::AlignCenter);
-    chartsLayout->addWidget(titleLabel);
-
-    if (!uniqueSports.isEmpty()) {
-        showSportDetails(0);
-    }
+    showSportDetails(sportsCombo->currentIndex());
 }
 
 void StatsDialog::updateTimePeriod(int index)
@@ -199,148 +198,117 @@ void StatsDialog::showSportDetails(int index)
 {
     if (index < 0 || index >= sportsCombo->count()) return;
 
-    QString sportName = sportsCombo->itemText(index);
-
-    // Очищаем предыдущие графики
-    QLayoutItem* child;
-    while ((child = chartsLayout->takeAt(0)) != nullptr) {
-        if (child->widget()) {
-            delete child->widget();
-        }
-        delete child;
-    }
-
-    // Фильтруем тренировки по виду спорта
-    QVector<WorkoutData> sportWorkouts;
-    for (const WorkoutData &workout : allWorkouts) {
-        if (workout.type == sportName) {
-            sportWorkouts.append(workout);
-        }
-    }
-
-    if (sportWorkouts.isEmpty()) {
-        QLabel *noDataLabel = new QLabel("Нет данных для отображения");
-        noDataLabel->setAlignment(Qt::AlignCenter);
-        chartsLayout->addWidget(noDataLabel);
-        return;
-    }
+    const QString sportName = sportsCombo->itemText(index);
 
     // Определяем границы периода с учетом сдвига
-    QDate currentDate = QDate::currentDate();
+    const StatsPeriod period = StatsPeriod(currentPeriod);
     QDate startDate, endDate;
-
-    switch(currentPeriod) {
-        case 0: {
-            startDate = currentDate.addDays(7 * currentShift).addDays(-(currentDate.dayOfWeek() - 1));
-            endDate = startDate.addDays(6);
-            break;
-        }
-        case 1: {
-            startDate = currentDate.addMonths(currentShift);
-            startDate = QDate(startDate.year(), startDate.month(), 1);
-            endDate = startDate.addMonths(1).addDays(-1);
-            break;
-        }
-        case 2: {
-            startDate = currentDate.addYears(currentShift);
-            startDate = QDate(startDate.year(), 1, 1);
-            endDate = QDate(startDate.year(), 12, 31);
-            break;
-        }
-    }
+    StatsEngine::periodRange(period, currentShift, QDate::currentDate(), startDate, endDate);
 
     currentStartDate = startDate;
     currentEndDate = endDate;
 
-    QVector<WorkoutData> periodWorkouts;
-    for (const WorkoutData &workout : sportWorkouts) {
-        if (workout.date >= startDate && workout.date <= endDate) {
-            periodWorkouts.append(workout);
-        }
+    const StatsCacheKey key{sportName, currentPeriod, currentShift};
+    const quint64 generation = ++m_generation;
+
+    // Сдвиг считается от сегодняшнего дня, поэтому сверяем и начало периода
+    const StatsResult *cached = m_cache.object(key);
+    if (cached && cached->start == startDate) {
+        showResult(sportName, *cached);
+        prefetchNeighbours(key);
+    } else {
+        // Показываем только результат последнего запроса
+        computeStats(key).then(this, [this, generation, key](const StatsResult &result) {
+            if (generation != m_generation) return;
+            showResult(key.sport, result);
+            prefetchNeighbours(key);
+        });
     }
 
-    // Сортируем по дате
-    std::sort(periodWorkouts.begin(), periodWorkouts.end(), [](const WorkoutData &a, const WorkoutData &b) {
-        return a.date < b.date;
-    });
+    updateNavigationButtons();
+}
 
-    // Группируем данные
-    QMap<QString, QVector<double>> durationData, caloriesData;
-    QStringList categories;
+QFuture<StatsResult> StatsDialog::computeStats(const StatsCacheKey &key)
+{
+    // Неделя и 90 дней строятся по дням, месяц - по ISO-неделям, год - по месяцам.
+    // Крайние недели месяца обрезаются по его границам. Считаем в пуле потоков
+    // по снимку индекса.
+    const StatsPeriod period = StatsPeriod(key.period);
+    QDate startDate, endDate;
+    StatsEngine::periodRange(period, key.shift, QDate::currentDate(), startDate, endDate);
 
-    switch(currentPeriod) {
-        case 0: {
-            for (const WorkoutData &w : periodWorkouts) {
-                QString dayStr = w.date.toString("dd.MM");
-                if (!categories.contains(dayStr)) {
-                    categories.append(dayStr);
-                }
-                durationData[dayStr].append(w.duration);
-                caloriesData[dayStr].append(w.calories);
-            }
-            break;
-        }
-        case 1: {
-            for (const WorkoutData &w : periodWorkouts) {
-                QDate weekStart = w.date.addDays(-(w.date.dayOfWeek() - 1));
-                QDate weekEnd = weekStart.addDays(6);
-                QString weekStr = QString("%1-%2").arg(
-                    weekStart.toString("dd.MM"),
-                    weekEnd.toString("dd.MM")
-                );
-                if (!categories.contains(weekStr)) {
-                    categories.append(weekStr);
-                }
-                durationData[weekStr].append(w.duration);
-                caloriesData[weekStr].append(w.calories);
-            }
-            break;
-        }
-        case 2: {
-            for (const WorkoutData &w : periodWorkouts) {
-                QString monthStr = QLocale().monthName(w.date.month(), QLocale::ShortFormat);
-                if (!categories.contains(monthStr)) {
-                    categories.append(monthStr);
-                }
-                durationData[monthStr].append(w.duration);
-                caloriesData[monthStr].append(w.calories);
-            }
-            break;
+    const RangeSnapshotPtr snapshot = rangeIndex->snapshot(key.sport);
+
+    return QtConcurrent::run([period, startDate, endDate, snapshot]() {
+        return StatsEngine::aggregate(period, startDate, endDate, *snapshot);
+    }).then(this, [this, key, snapshot](const StatsResult &result) {
+        // Пока считали, дерево могло измениться или быть сброшено
+        if (snapshot->revision() == rangeIndex->revision(key.sport)) {
+            m_cache.insert(key, new StatsResult(result));
         }
+        return result;
+    });
+}
+
+void StatsDialog::prefetchNeighbours(const StatsCacheKey &key)
+{
+    // Соседние периоды считаем заранее, чтобы ◀/▶ брали их из кэша
+    for (int direction : {-1, 1}) {
+        const StatsCacheKey neighbour{key.sport, key.period, key.shift + direction};
+        if (m_cache.contains(neighbour) || m_prefetching.contains(neighbour)) continue;
+
+        m_prefetching.insert(neighbour);
+        computeStats(neighbour).then(this, [this, neighbour](const StatsResult &) {
+            m_prefetching.remove(neighbour);
+        });
     }
+}
 
-    QVector<double> durations, calories, intensities;
-    for (const QString &category : categories) {
-        double totalDuration = 0, totalCalories = 0;
-        int count = durationData[category].size();
+void StatsDialog::showResult(const QString &sportName, const StatsResult &result)
+{
+    const StatsPeriod period = result.period;
+    const QDate startDate = result.start;
+    const QDate endDate = result.end;
+    const bool daily = period == StatsPeriod::Week || period == StatsPeriod::Last90Days;
 
-        for (double val : durationData[category]) {
-            totalDuration += val;
-        }
-        for (double val : caloriesData[category]) {
-            totalCalories += val;
+    QStringList categories;
+    QVector<double> durations, calories, intensities;
+    categories.reserve(result.buckets.size());
+    durations.reserve(result.buckets.size());
+    calories.reserve(result.buckets.size());
+    intensities.reserve(result.buckets.size());
+
+    for (const StatsBucket &bucket : result.buckets) {
+        switch(period) {
+            case StatsPeriod::Week:
+            case StatsPeriod::Last90Days:
+                categories.append(bucket.start.toString("dd.MM"));
+                break;
+            case StatsPeriod::Month:
+                categories.append(QString("%1-%2").arg(
+                    bucket.start.toString("dd.MM"),
+                    bucket.end.toString("dd.MM")
+                ));
+                break;
+            case StatsPeriod::Year:
+                categories.append(QLocale().monthName(bucket.start.month(), QLocale::ShortFormat));
+                break;
         }
 
-        if (currentPeriod == 0) {
-            durations.append(qRound(totalDuration * 10) / 10.0);
-            calories.append(qRound(totalCalories * 10) / 10.0);
+        // По дням показываем суммы, по неделям и месяцам - средние
+        if (daily) {
+            durations.append(qRound(bucket.totalDuration * 10) / 10.0);
+            calories.append(qRound(bucket.totalCalories * 10) / 10.0);
         } else {
-            durations.append(count > 0 ? qRound((totalDuration / count) * 10) / 10.0 : 0);
-            calories.append(count > 0 ? qRound((totalCalories / count) * 10) / 10.0 : 0);
-        }
-
-        // Интенсивность (ккал/мин)
-        double intensity = 0;
-        if (totalDuration > 0) {
-            intensity = totalCalories / totalDuration;
-            intensity = qRound(intensity * 10) / 10.0;
+            durations.append(qRound(bucket.meanDuration() * 10) / 10.0);
+            calories.append(qRound(bucket.meanCalories() * 10) / 10.0);
         }
-        intensities.append(intensity);
+        intensities.append(qRound(bucket.intensity() * 10) / 10.0);
     }
 
-    // Добавляем метку с периодом
+    // Метка с периодом
     QString periodLabelText;
-    switch(currentPeriod) {
+    switch(int(period)) {
         case 0: // Неделя
             periodLabelText = QString("Неделя: %1 - %2")
                 .arg(startDate.toString("dd.MM.yyyy"))
@@ -353,137 +321,69 @@ void StatsDialog::showSportDetails(int index)
         case 2: // Год
             periodLabelText = QString("Год: %1").arg(startDate.year());
             break;
+        case 3: // 90 дней
+            periodLabelText = QString("90 дней: %1 - %2")
+                .arg(startDate.toString("dd.MM.yyyy"))
+                .arg(endDate.toString("dd.MM.yyyy"));
+            break;
     }
 
-    QLabel *periodInfoLabel = new QLabel(periodLabelText);
-    periodInfoLabel->setAlignment(Qt::AlignCenter);
-    periodInfoLabel->setStyleSheet("QLabel { font-weight: bold; font-size: 14px; margin-bottom: 10px; }");
-    chartsLayout->addWidget(periodInfoLabel);
-
-    // Создаем графики
-    if (!durations.isEmpty()) {
-        QString title = currentPeriod == 0 ? "Длительность тренировок (" + sportName + ")"
-                      : "Средняя длительность (" + sportName + ")";
-        createScrollableChart(title, "Минуты", categories, durations, "мин");
-    }
-    if (!calories.isEmpty()) {
-        QString title = currentPeriod == 0 ? "Сожженные калории (" + sportName + ")"
-                      : "Средние калории (" + sportName + ")";
-        createScrollableChart(title, "Ккал", categories, calories, "ккал");
-    }
-    if (!intensities.isEmpty()) {
-        createScrollableChart("Интенсивность (" + sportName + ")", "Ккал/мин", categories, intensities, "ккал/мин");
-    }
-
-    updateNavigationButtons();
+    periodLabelText += QString("\nТренировок: %1, минут: %2, ккал: %3")
+        .arg(result.summary.count)
+        .arg(qint64(result.summary.totalDuration))
+        .arg(qint64(result.summary.totalCalories));
+
+    periodInfoLabel->setText(periodLabelText);
+    periodInfoLabel->show();
+
+    // Обновляем данные графиков
+    updateChart(durationChart, daily ? "Длительность тренировок (" + sportName + ")"
+                                     : "Средняя длительность (" + sportName + ")",
+                categories, durations, daily);
+    updateChart(caloriesChart, daily ? "Сожженные калории (" + sportName + ")"
+                                     : "Средние калории (" + sportName + ")",
+                categories, calories, daily);
+    updateChart(intensityChart, "Интенсивность (" + sportName + ")", categories, intensities, daily);
 }
 
-void StatsDialog::createScrollableChart(const QString &title, const QString &yTitle,
-                                      const QStringList &categories, const QVector<double> &values,
-                                      const QString &unit)
+StatsDialog::TrendChart StatsDialog::createScrollableChart(const QString &yTitle, const QString &unit,
+                                                           const QColor &color)
 {
-    if (categories.isEmpty() || values.isEmpty()) return;
+    TrendChart trend;
 
-    QWidget *chartContainer = new QWidget();
-    QVBoxLayout *containerLayout = new QVBoxLayout(chartContainer);
+    trend.container = new QWidget();
+    QVBoxLayout *containerLayout = new QVBoxLayout(trend.container);
     containerLayout->setContentsMargins(0, 0, 0, 0);
     containerLayout->setSpacing(5);
 
     // Заголовок
-    QLabel *titleLabel = new QLabel(QString("<h3>%1</h3>").arg(title));
-    titleLabel->setAlignment(Qt::AlignCenter);
-    titleLabel->setStyleSheet("QLabel { margin-bottom: 5px; }");
-    containerLayout->addWidget(titleLabel);
-
-    // Область прокрутки
-    QScrollArea *scrollArea = new QScrollArea();
-    scrollArea->setWidgetResizable(true);
-    scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
-    scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    scrollArea->setMinimumHeight(300);
-    scrollArea->setStyleSheet("QScrollArea { border: none; }");
-
-    QWidget *scrollContent = new QWidget();
-    QHBoxLayout *contentLayout = new QHBoxLayout(scrollContent);
-    contentLayout->setContentsMargins(0, 0, 0, 0);
-
-    // Создаем график
-    QChart *chart = new QChart();
-    chart->setAnimationOptions(QChart::SeriesAnimations);
-    chart->setMargins(QMargins(5, 5, 5, 5));
-    chart->legend()->hide();
-    chart->setBackgroundRoundness(0);
-    chart->setBackgroundBrush(Qt::white);
-
-    // Линия данных
-    QLineSeries *series = new QLineSeries();
-    series->setName(yTitle);
-
-    double minVal = std::numeric_limits<double>::max();
-    double maxVal = std::numeric_limits<double>::min();
-
-    for (int i = 0; i < values.size(); ++i) {
-        series->append(i, values[i]);
-        if (values[i] < minVal) minVal = values[i];
-        if (values[i] > maxVal) maxVal = values[i];
-    }
-
-    // Стиль линии
-    QPen pen(QColor("#4285F4"), 2);
-    if (title.contains("калории", Qt::CaseInsensitive)) {
-        pen.setColor(QColor("#34A853"));
-    } else if (title.contains("Интенсивность")) {
-        pen.setColor(QColor("#EA4335"));
-    }
-    series->setPen(pen);
-    series->setPointsVisible(true);
-
-    // Настройка точек
-    series->setPointLabelsFormat("@yPoint " + unit);
-    series->setPointLabelsVisible(true);
-    series->setPointLabelsFont(QFont("Arial", 8));
-    series->setPointLabelsColor(pen.color().darker());
-
-    chart->addSeries(series);
-
-    // Ось X
-    QBarCategoryAxis *axisX = new QBarCategoryAxis();
-    axisX->append(categories);
-    axisX->setTitleText("Период");
-    axisX->setLabelsAngle(currentPeriod == 0 ? -45 : 0);
-    axisX->setLabelsFont(QFont("Arial", 8));
-    chart->addAxis(axisX, Qt::AlignBottom);
-    series->attachAxis(axisX);
-
-    // Ось Y
-    QValueAxis *axisY = new QValueAxis();
-    axisY->setTitleText(yTitle);
-    axisY->setLabelFormat("%.1f");
-    axisY->setLabelsFont(QFont("Arial", 8));
-
-    double range = maxVal - minVal;
-    if (range < 0.1) {
-        axisY->setRange(0, maxVal * 1.5);
-    } else {
-        axisY->setRange(qMax(0.0, minVal - range * 0.1), maxVal + range * 0.1);
-    }
-    axisY->applyNiceNumbers();
-
-    chart->addAxis(axisY, Qt::AlignLeft);
-    series->attachAxis(axisY);
-
-    // Отображение графика
-    QChartView *chartView = new QChartView(chart);
-    chartView->setRenderHint(QPainter::Antialiasing);
-    chartView->setMinimumWidth(qMax(600, categories.size() * 80));
-    chartView->setStyleSheet("background: white;");
-    chartView->setRubberBand(QChartView::NoRubberBand);
-    chartView->setInteractive(false);
+    trend.titleLabel = new QLabel();
+    trend.titleLabel->setAlignment(Qt::AlignCenter);
+    Theme::setVariant(trend.titleLabel, "chartTitle");
+    containerLayout->addWidget(trend.titleLabel);
+
+    // График рисуется сам и прореживает ряд под свою ширину,
+    // поэтому прокрутка по горизонтали не нужна
+    trend.chart = new TrendChartWidget();
+    trend.chart->setAxisTitle(yTitle);
+    trend.chart->setUnit(unit);
+    trend.chart->setColor(color);
+    containerLayout->addWidget(trend.chart);
+
+    chartsLayout->addWidget(trend.container);
+
+    // Показывается после первой порции данных
+    trend.container->hide();
+    return trend;
+}
 
-    contentLayout->addWidget(chartView);
-    scrollContent->setLayout(contentLayout);
-    scrollArea->setWidget(scrollContent);
+void StatsDialog::updateChart(TrendChart &trend, const QString &title, const QStringList &categories,
+                              const QVector<double> &values, bool daily)
+{
+    trend.container->setVisible(!values.isEmpty());
+    if (values.isEmpty()) return;
 
-    containerLayout->addWidget(scrollArea);
-    chartsLayout->addWidget(chartContainer);
+    trend.titleLabel->setText(QString("<h3>%1</h3>").arg(title));
+    trend.chart->setRotatedLabels(daily);
+    trend.chart->setData(categories, values);
 }
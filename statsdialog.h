@@ -5,29 +5,49 @@
 #include <QHBoxLayout>
 #include "mainwindow.h"
 
-#include <QtCharts/QChartView>
-#include <QtCharts/QBarSeries>
-#include <QtCharts/QBarSet>
-#include <QtCharts/QValueAxis>
-#include <QtCharts/QLineSeries>
 #include <QComboBox>
+#include <QCache>
+#include <QSet>
+#include <QFuture>
+#include "statsengine.h"
 
 QT_BEGIN_NAMESPACE
-class QChartView;
-class QChart;
-class QBarSeries;
-class QBarSet;
-class QValueAxis;
-class QLineSeries;
+class QLabel;
+class QScrollArea;
 QT_END_NAMESPACE
 
+class Database;
+class RangeIndex;
+class TrendChartWidget;
+
+// Ключ кэша статистики: вид спорта, период и сдвиг от текущего
+struct StatsCacheKey {
+    QString sport;
+    int period = 0;
+    int shift = 0;
+
+    bool operator==(const StatsCacheKey &other) const
+    {
+        return period == other.period && shift == other.shift && sport == other.sport;
+    }
+};
+
+inline size_t qHash(const StatsCacheKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.sport, key.period, key.shift);
+}
+
 class StatsDialog : public QDialog
 {
     Q_OBJECT
 
 public:
-    explicit StatsDialog(const QVector<WorkoutData>& workouts, QWidget *parent = nullptr);
-    void updateData(const QVector<WorkoutData>& workouts);
+    StatsDialog(Database *database, RangeIndex *rangeIndex, QWidget *parent = nullptr);
+    void refresh();
+
+    // Сбрасывает кэшированные периоды, в которые попадает тренировка
+    void invalidate(const QString &type, const QDate &date);
+    void invalidateAll();
 
 private slots:
     void showSportDetails(int index);
@@ -41,28 +61,50 @@ private:
     QPushButton *prevPeriodButton;
     QPushButton *nextPeriodButton;
     QString getWeekRangeString(const QDate &date) const;
-    void setupCharts(const QVector<WorkoutData>& workouts, QVBoxLayout *layout);
-    QVector<WorkoutData> filterWorkoutsByPeriod(const QVector<WorkoutData>& workouts);
-    void createScrollableChart(const QString &title, const QString &yTitle,
-                             const QStringList &dates, const QVector<double> &values,
-                             const QString &unit);
+    void showResult(const QString &sportName, const StatsResult &result);
+    QFuture<StatsResult> computeStats(const StatsCacheKey &key);
+    void prefetchNeighbours(const StatsCacheKey &key);
+    void setupCharts();
+
+    // График живёт всё время жизни окна, при смене периода
+    // меняются только данные
+    struct TrendChart {
+        QWidget *container = nullptr;
+        QLabel *titleLabel = nullptr;
+        TrendChartWidget *chart = nullptr;
+    };
+    TrendChart createScrollableChart(const QString &yTitle, const QString &unit, const QColor &color);
+    void updateChart(TrendChart &trend, const QString &title, const QStringList &categories,
+                     const QVector<double> &values, bool daily);
+
+    TrendChart durationChart;
+    TrendChart caloriesChart;
+    TrendChart intensityChart;
+    QLabel *periodInfoLabel;
+    QLabel *noDataLabel;
 
     QScrollArea *chartsScrollArea;
     QWidget *scrollContent;
     QHBoxLayout *scrollLayout;
-    QList<QChartView*> chartViews;
     int currentChartIndex = 0;
 
     void updateChartsNavigation();
     void showChart(int index);
 
     QVBoxLayout *currentLayout;
-    QVector<WorkoutData> allWorkouts;
+    Database *database;
+    RangeIndex *rangeIndex;
     QComboBox *sportsCombo;
     QComboBox *periodCombo;
     QWidget *chartsContainer;
     QVBoxLayout *chartsLayout;
     int currentPeriod = 0;
+    quint64 m_generation = 0;   // номер последнего запроса статистики
+
+    // Последние рассчитанные периоды (LRU). Результат попадает в кэш,
+    // только если дерево вида спорта не менялось, пока он считался.
+    QCache<StatsCacheKey, StatsResult> m_cache;
+    QSet<StatsCacheKey> m_prefetching;
     QDate currentStartDate;
     QDate currentEndDate;
 };
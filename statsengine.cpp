@@ -0,0 +1,174 @@
+#include "statsengine.h"
+#include "rangeindex.h"
+#include <algorithm>
+#include <cmath>
+
+double StatsBucket::meanDuration() const
+{
+    return count > 0 ? totalDuration / count : 0;
+}
+
+double StatsBucket::meanCalories() const
+{
+    return count > 0 ? totalCalories / count : 0;
+}
+
+double StatsBucket::intensity() const
+{
+    return totalDuration > 0 ? totalCalories / totalDuration : 0;
+}
+
+void StatsEngine::periodRange(StatsPeriod period, int shift, const QDate &today,
+                              QDate &start, QDate &end)
+{
+    switch (period) {
+        case StatsPeriod::Week:
+            start = today.addDays(7 * shift).addDays(-(today.dayOfWeek() - 1));
+            end = start.addDays(6);
+            break;
+        case StatsPeriod::Month:
+            start = today.addMonths(shift);
+            start = QDate(start.year(), start.month(), 1);
+            end = start.addMonths(1).addDays(-1);
+            break;
+        case StatsPeriod::Year:
+            start = today.addYears(shift);
+            start = QDate(start.year(), 1, 1);
+            end = QDate(start.year(), 12, 31);
+            break;
+        case StatsPeriod::Last90Days:
+            end = today.addDays(90 * shift);
+            start = end.addDays(-89);
+            break;
+    }
+}
+
+QVector<int> StatsEngine::bucketBoundaries(StatsPeriod period, const QDate &start, const QDate &end)
+{
+    QVector<int> boundaries;
+    const int endDay = int(end.toJulianDay()) + 1;
+
+    switch (period) {
+        case StatsPeriod::Week:
+        case StatsPeriod::Last90Days:
+            for (int day = int(start.toJulianDay()); day < endDay; ++day) {
+                boundaries.append(day);
+            }
+            break;
+        case StatsPeriod::Month: {
+            // Недели, пересекающиеся с месяцем; aggregate обрезает крайние по месяцу
+            const int firstMonday = int(start.addDays(-(start.dayOfWeek() - 1)).toJulianDay());
+            for (int day = firstMonday; day < endDay; day += 7) {
+                boundaries.append(day);
+            }
+            boundaries.append(boundaries.last() + 7);
+            return boundaries;
+        }
+        case StatsPeriod::Year:
+            for (QDate month = start; month <= end; month = month.addMonths(1)) {
+                boundaries.append(int(month.toJulianDay()));
+            }
+            break;
+    }
+
+    boundaries.append(endDay);
+    return boundaries;
+}
+
+StatsResult StatsEngine::aggregate(StatsPeriod period, const QDate &start, const QDate &end,
+                                   const RangeSnapshot &snapshot)
+{
+    StatsResult result;
+    result.period = period;
+    result.start = start;
+    result.end = end;
+
+    // Крайние недели месяца обрезаются по границам периода,
+    // чтобы столбцы и итог считались по одним и тем же дням
+    const QVector<int> boundaries = bucketBoundaries(period, start, end);
+    for (int i = 0; i + 1 < boundaries.size(); ++i) {
+        const QDate bucketStart = qMax(QDate::fromJulianDay(boundaries[i]), start);
+        const QDate bucketEnd = qMin(QDate::fromJulianDay(boundaries[i + 1] - 1), end);
+        const RangeTotals totals = snapshot.total(bucketStart, bucketEnd);
+        if (totals.count <= 0) continue;
+
+        StatsBucket &bucket = result.buckets.emplaceBack();
+        bucket.index = i;
+        bucket.start = bucketStart;
+        bucket.end = bucketEnd;
+        bucket.count = totals.count;
+        bucket.totalDuration = totals.duration;
+        bucket.totalCalories = totals.calories;
+    }
+
+    const RangeTotals totals = snapshot.total(start, end);
+    result.summary.start = start;
+    result.summary.count = totals.count;
+    result.summary.totalDuration = totals.duration;
+    result.summary.totalCalories = totals.calories;
+    return result;
+}
+
+QVector<int> StatsEngine::downsample(const QVector<double> &values, int threshold)
+{
+    const int size = values.size();
+    threshold = qMax(threshold, 3);
+
+    QVector<int> indices;
+    if (size <= threshold) {
+        indices.reserve(size);
+        for (int i = 0; i < size; ++i) {
+            indices.append(i);
+        }
+        return indices;
+    }
+
+    indices.reserve(threshold);
+    indices.append(0);
+
+    // Крайние точки фиксированы, остальные делятся на threshold - 2 корзины;
+    // из каждой берём точку, образующую наибольший треугольник с предыдущей
+    // выбранной и средним следующей корзины
+    const double every = double(size - 2) / (threshold - 2);
+    int previous = 0;
+
+    for (int i = 0; i < threshold - 2; ++i) {
+        const int averageStart = int(std::floor((i + 1) * every)) + 1;
+        const int averageEnd = qMin(int(std::floor((i + 2) * every)) + 1, size);
+
+        double averageX = 0;
+        double averageY = 0;
+        for (int j = averageStart; j < averageEnd; ++j) {
+            averageX += j;
+            averageY += values[j];
+        }
+        const int averageCount = averageEnd - averageStart;
+        if (averageCount > 0) {
+            averageX /= averageCount;
+            averageY /= averageCount;
+        } else {
+            averageX = size - 1;
+            averageY = values[size - 1];
+        }
+
+        const int rangeStart = int(std::floor(i * every)) + 1;
+        const int rangeEnd = int(std::floor((i + 1) * every)) + 1;
+
+        double maxArea = -1;
+        int selected = rangeStart;
+        for (int j = rangeStart; j < rangeEnd; ++j) {
+            const double area = std::abs((previous - averageX) * (values[j] - values[previous])
+                                         - (previous - j) * (averageY - values[previous]));
+            if (area > maxArea) {
+                maxArea = area;
+                selected = j;
+            }
+        }
+
+        indices.append(selected);
+        previous = selected;
+    }
+
+    indices.append(size - 1);
+    return indices;
+}
@@ -0,0 +1,61 @@
+#ifndef STATSENGINE_H
+#define STATSENGINE_H
+
+#include <QDate>
+#include <QVector>
+#include <QString>
+
+class RangeSnapshot;
+
+// Период статистики; значения совпадают с индексами periodCombo
+enum class StatsPeriod {
+    Week = 0,   // столбцы по дням
+    Month = 1,  // столбцы по ISO-неделям
+    Year = 2,   // столбцы по месяцам
+    Last90Days = 3  // скользящее окно, столбцы по дням
+};
+
+struct StatsBucket {
+    int index = 0;        // номер столбца от начала периода
+    QDate start;          // первый день столбца
+    QDate end;            // последний день столбца
+    int count = 0;
+    double totalDuration = 0;
+    double totalCalories = 0;
+
+    double meanDuration() const;
+    double meanCalories() const;
+    double intensity() const;   // ккал/мин
+};
+
+struct StatsResult {
+    StatsPeriod period = StatsPeriod::Week;
+    QDate start;
+    QDate end;
+    QVector<StatsBucket> buckets;   // только непустые, по возрастанию даты
+    StatsBucket summary;            // итог за [start, end]
+};
+
+// Агрегация статистики по столбцам с целочисленными границами (номера
+// юлианских дней), без строковых ключей и промежуточных копий.
+class StatsEngine
+{
+public:
+    // Границы периода, сдвинутого на shift периодов от today
+    static void periodRange(StatsPeriod period, int shift, const QDate &today,
+                            QDate &start, QDate &end);
+
+    // Первые дни столбцов периода плюс день после последнего
+    static QVector<int> bucketBoundaries(StatsPeriod period, const QDate &start, const QDate &end);
+
+    // Суммы столбцов по снимку вида спорта: O(log n) на столбец, без чтения записей
+    static StatsResult aggregate(StatsPeriod period, const QDate &start, const QDate &end,
+                                 const RangeSnapshot &snapshot);
+
+    // Прореживание ряда для графика (Largest-Triangle-Three-Buckets):
+    // индексы не более threshold точек, сохраняющих форму линии.
+    // Первая и последняя точки остаются всегда.
+    static QVector<int> downsample(const QVector<double> &values, int threshold);
+};
+
+#endif // STATSENGINE_H
@@ -0,0 +1,248 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QLoggingCategory>
+#include "connectionprofile.h"
+#include "database.h"
+#include "testhelpers.h"
+
+static const QString InsertSql =
+    "INSERT INTO workouts (type, duration, sets, reps, calories, notes, day) "
+    "VALUES (:type, :duration, :sets, :reps, :calories, :notes, :day)";
+
+static void bindWorkout(QSqlQuery &query, const WorkoutData &workout)
+{
+    query.bindValue(":type", workout.type);
+    query.bindValue(":duration", workout.duration);
+    query.bindValue(":sets", workout.sets);
+    query.bindValue(":reps", workout.reps);
+    query.bindValue(":calories", workout.calories);
+    query.bindValue(":notes", workout.notes);
+    query.bindValue(":day", workout.date.toJulianDay());
+}
+
+// Отдельный файл на каждый профиль: journal_mode сохраняется в самом файле
+static bool openProfileConnection(const QString &name, const QString &profile, bool recreate = true)
+{
+    const QString fileName = QString("profile_%1.db").arg(profile);
+    if (recreate) {
+        QFile::remove(fileName);
+    }
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", name);
+    db.setDatabaseName(fileName);
+    if (!db.open() || !ConnectionProfile::fromName(profile).apply(db)) {
+        return false;
+    }
+
+    QSqlQuery query(db);
+    return query.exec("CREATE TABLE IF NOT EXISTS workouts ("
+                      "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                      "type TEXT NOT NULL, "
+                      "duration INTEGER NOT NULL, "
+                      "sets INTEGER, "
+                      "reps INTEGER, "
+                      "calories INTEGER, "
+                      "notes TEXT, "
+                      "day INTEGER NOT NULL)")
+        && query.exec("CREATE INDEX IF NOT EXISTS idx_workouts_day ON workouts(day)");
+}
+
+static void closeConnection(const QString &name)
+{
+    {
+        QSqlDatabase db = QSqlDatabase::database(name, false);
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(name);
+}
+
+// Задержка записи одной строки. Каждая итерация QBENCHMARK - одна тренировка,
+// поэтому результат сразу получается в пересчёте на строку.
+class BenchDatabase : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    // До: запрос готовится заново для каждой строки
+    void insertPreparedPerRow();
+    // После: один подготовленный запрос, меняются только значения
+    void insertCachedStatement();
+    // Database::addWorkout целиком, со сводкой и фиксацией транзакции
+    void addWorkout();
+    // Database::addWorkouts, пачка из 1000 строк в одной транзакции
+    void addWorkoutsBatch();
+
+    // Профили соединения: запись строки с фиксацией и чтение дня
+    // с другого соединения, пока идёт незавершённая запись
+    void profileInsert_data();
+    void profileInsert();
+    void profileReadDuringWrite_data();
+    void profileReadDuringWrite();
+
+private:
+    QTemporaryDir dir;
+    QString previousDir;
+    Database *database = nullptr;
+    QSqlDatabase raw;
+};
+
+void BenchDatabase::initTestCase()
+{
+    // Database пишет в workout_tracker.db в текущем каталоге
+    QVERIFY(dir.isValid());
+    previousDir = QDir::currentPath();
+    QDir::setCurrent(dir.path());
+
+    // Построчный отладочный вывод Database исказил бы замеры
+    QLoggingCategory::setFilterRules("default.debug=false");
+
+    database = new Database(nullptr, "bench");
+    raw = QSqlDatabase::addDatabase("QSQLITE", "bench_raw");
+    raw.setDatabaseName("workout_tracker.db");
+    QVERIFY(raw.open());
+}
+
+void BenchDatabase::cleanupTestCase()
+{
+    raw.close();
+    raw = QSqlDatabase();
+    QSqlDatabase::removeDatabase("bench_raw");
+
+    database->closeDatabase();
+    delete database;
+    QSqlDatabase::removeDatabase("bench");
+
+    QLoggingCategory::setFilterRules(QString());
+    QDir::setCurrent(previousDir);
+}
+
+void BenchDatabase::insertPreparedPerRow()
+{
+    // Транзакция открыта на весь замер, чтобы fsync не заслонял подготовку запроса
+    const WorkoutData workout = makeWorkout(QDate(2024, 5, 1));
+    QVERIFY(raw.transaction());
+    QBENCHMARK {
+        QSqlQuery query(raw);
+        query.prepare(InsertSql);
+        bindWorkout(query, workout);
+        QVERIFY(query.exec());
+    }
+    raw.rollback();
+}
+
+void BenchDatabase::insertCachedStatement()
+{
+    const WorkoutData workout = makeWorkout(QDate(2024, 5, 1));
+    QSqlQuery query(raw);
+    QVERIFY(query.prepare(InsertSql));
+    QVERIFY(raw.transaction());
+    QBENCHMARK {
+        bindWorkout(query, workout);
+        QVERIFY(query.exec());
+    }
+    query.finish();
+    raw.rollback();
+}
+
+void BenchDatabase::addWorkout()
+{
+    WorkoutData workout = makeWorkout(QDate(2024, 5, 1));
+    QBENCHMARK {
+        QVERIFY(database->addWorkout(workout));
+    }
+}
+
+void BenchDatabase::addWorkoutsBatch()
+{
+    QVector<WorkoutData> workouts;
+    for (int i = 0; i < 1000; ++i) {
+        workouts.append(makeWorkout(QDate(2024, 1, 1).addDays(i % 366)));
+    }
+    QBENCHMARK {
+        QVERIFY(database->addWorkouts(workouts));
+    }
+}
+
+void BenchDatabase::profileInsert_data()
+{
+    QTest::addColumn<QString>("profile");
+    for (const QString &profile : ConnectionProfile::availableProfiles()) {
+        QTest::newRow(qPrintable(profile)) << profile;
+    }
+}
+
+void BenchDatabase::profileInsert()
+{
+    QFETCH(QString, profile);
+    QVERIFY(openProfileConnection("bench_profile", profile));
+
+    {
+        // Без явной транзакции каждая строка фиксируется отдельно,
+        // так видна цена journal_mode и synchronous
+        const WorkoutData workout = makeWorkout(QDate(2024, 5, 1));
+        QSqlQuery query(QSqlDatabase::database("bench_profile"));
+        QVERIFY(query.prepare(InsertSql));
+        QBENCHMARK {
+            bindWorkout(query, workout);
+            QVERIFY(query.exec());
+        }
+    }
+
+    closeConnection("bench_profile");
+}
+
+void BenchDatabase::profileReadDuringWrite_data()
+{
+    profileInsert_data();
+}
+
+void BenchDatabase::profileReadDuringWrite()
+{
+    QFETCH(QString, profile);
+    QVERIFY(openProfileConnection("bench_writer", profile));
+    QVERIFY(openProfileConnection("bench_reader", profile, false));
+
+    {
+        QSqlDatabase writer = QSqlDatabase::database("bench_writer");
+        QSqlDatabase reader = QSqlDatabase::database("bench_reader");
+
+        // Месяц тренировок, по три в день
+        QVERIFY(writer.transaction());
+        QSqlQuery insert(writer);
+        QVERIFY(insert.prepare(InsertSql));
+        for (int i = 0; i < 90; ++i) {
+            bindWorkout(insert, makeWorkout(QDate(2024, 5, 1).addDays(i / 3)));
+            QVERIFY(insert.exec());
+        }
+        QVERIFY(writer.commit());
+
+        // Запись начата, но не зафиксирована
+        QVERIFY(writer.transaction());
+        bindWorkout(insert, makeWorkout(QDate(2024, 5, 15)));
+        QVERIFY(insert.exec());
+
+        QSqlQuery select(reader);
+        QVERIFY(select.prepare("SELECT id, type, duration, calories FROM workouts WHERE day = :day"));
+        QBENCHMARK {
+            select.bindValue(":day", QDate(2024, 5, 15).toJulianDay());
+            QVERIFY(select.exec());
+            int rows = 0;
+            while (select.next()) ++rows;
+            QCOMPARE(rows, 3);
+        }
+        select.finish();
+
+        insert.finish();
+        writer.rollback();
+    }
+
+    closeConnection("bench_reader");
+    closeConnection("bench_writer");
+}
+
+QTEST_GUILESS_MAIN(BenchDatabase)
+
+#include "bench_database.moc"
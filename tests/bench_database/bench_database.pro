@@ -0,0 +1,14 @@
+include(../tests.pri)
+
+TARGET = bench_database
+
+SOURCES += \
+    bench_database.cpp \
+    $$APP_DIR/connectionprofile.cpp \
+    $$APP_DIR/database.cpp \
+    $$APP_DIR/workoutstore.cpp
+
+HEADERS += \
+    $$APP_DIR/connectionprofile.h \
+    $$APP_DIR/database.h \
+    $$APP_DIR/workoutstore.h
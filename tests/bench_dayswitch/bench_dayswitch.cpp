@@ -0,0 +1,248 @@
+#include <QtTest>
+#include <QApplication>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QGroupBox>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QScrollArea>
+#include <QListView>
+#include "workoutlistmodel.h"
+#include "workoutcarddelegate.h"
+#include "testhelpers.h"
+
+// Тренировки одного дня с уникальными id
+static QVector<WorkoutData> makeDay(const QDate &date, int count, int firstId)
+{
+    QVector<WorkoutData> day;
+    for (int i = 0; i < count; ++i) {
+        WorkoutData workout = makeWorkout(date, 30 + i % 60, 200 + i * 10);
+        workout.id = firstId + i;
+        workout.sets = 3;
+        workout.reps = 12;
+        workout.notes = "Заметка";
+        day.append(workout);
+    }
+    return day;
+}
+
+static void addTableRow(QTableWidget *table, int row, const QString &label, const QString &value)
+{
+    QTableWidgetItem *labelItem = new QTableWidgetItem(label);
+    labelItem->setFlags(labelItem->flags() ^ Qt::ItemIsEditable);
+    labelItem->setForeground(QColor("#505050"));
+
+    QTableWidgetItem *valueItem = new QTableWidgetItem(value);
+    valueItem->setFlags(valueItem->flags() ^ Qt::ItemIsEditable);
+    valueItem->setForeground(Qt::black);
+
+    table->setItem(row, 0, labelItem);
+    table->setItem(row, 1, valueItem);
+}
+
+// Прежний updateWorkoutsDisplay: layout очищается и на каждую
+// тренировку собирается QGroupBox с заголовком и скрытой таблицей
+static void rebuildCards(QVBoxLayout *layout, const QVector<WorkoutData> &workouts)
+{
+    QLayoutItem *item;
+    while ((item = layout->takeAt(0)) != nullptr) {
+        delete item->widget();
+        delete item;
+    }
+
+    for (const WorkoutData &workout : workouts) {
+        QGroupBox *workoutGroup = new QGroupBox();
+        workoutGroup->setContextMenuPolicy(Qt::CustomContextMenu);
+
+        QVBoxLayout *groupLayout = new QVBoxLayout(workoutGroup);
+        groupLayout->setSpacing(0);
+
+        QWidget *headerWidget = new QWidget();
+        QHBoxLayout *headerLayout = new QHBoxLayout(headerWidget);
+        headerLayout->setContentsMargins(10, 5, 10, 5);
+
+        QLabel *titleLabel = new QLabel(workout.type);
+        titleLabel->setStyleSheet("font-weight: bold; font-size: 14px;");
+
+        QLabel *summaryLabel = new QLabel(QString("%1 мин · %2 подх.").arg(workout.duration).arg(workout.sets));
+        summaryLabel->setStyleSheet("color: #666;");
+
+        QPushButton *toggleButton = new QPushButton("▼");
+        toggleButton->setFixedSize(24, 24);
+        toggleButton->setStyleSheet(
+            "QPushButton {"
+            "   border: none;"
+            "   background: transparent;"
+            "   font-size: 12px;"
+            "}"
+        );
+
+        headerLayout->addWidget(titleLabel);
+        headerLayout->addWidget(summaryLabel);
+        headerLayout->addStretch();
+        headerLayout->addWidget(toggleButton);
+
+        QTableWidget *detailsTable = new QTableWidget();
+        detailsTable->setColumnCount(2);
+        detailsTable->setRowCount(4);
+        detailsTable->verticalHeader()->hide();
+        detailsTable->horizontalHeader()->hide();
+        detailsTable->setShowGrid(false);
+        detailsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        detailsTable->setSelectionMode(QAbstractItemView::NoSelection);
+        detailsTable->setStyleSheet(
+            "QTableWidget {"
+            "   background-color: #f0f0f0;"
+            "   border: 1px solid #c0c0c0;"
+            "   border-radius: 5px;"
+            "   margin: 5px;"
+            "   gridline-color: transparent;"
+            "}"
+            "QTableWidget QTableCornerButton::section {"
+            "   background: #e0e0e0;"
+            "   border: 1px solid #c0c0c0;"
+            "}"
+            "QTableWidget::item {"
+            "   padding: 5px 10px;"
+            "   border: none;"
+            "   background: transparent;"
+            "}"
+            "QTableWidget::item:selected {"
+            "   background: #d8d8d8;"
+            "}"
+        );
+
+        QPalette palette = detailsTable->palette();
+        palette.setColor(QPalette::Base, QColor(240, 240, 240));
+        palette.setColor(QPalette::Window, QColor(240, 240, 240));
+        detailsTable->setPalette(palette);
+        detailsTable->setAutoFillBackground(true);
+
+        addTableRow(detailsTable, 0, "Длительность:", QString("%1 мин").arg(workout.duration));
+        addTableRow(detailsTable, 1, "Подходы:", QString::number(workout.sets));
+        addTableRow(detailsTable, 2, "Повторения:", QString::number(workout.reps));
+        addTableRow(detailsTable, 3, "Ккал:", QString::number(workout.calories));
+
+        detailsTable->setColumnWidth(0, 120);
+        detailsTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+        detailsTable->setFixedHeight(detailsTable->rowHeight(0) * detailsTable->rowCount() + 12);
+        detailsTable->setVisible(false);
+
+        groupLayout->addWidget(headerWidget);
+        groupLayout->addWidget(detailsTable);
+
+        QObject::connect(toggleButton, &QPushButton::clicked, detailsTable, [toggleButton, detailsTable]() {
+            const bool isVisible = detailsTable->isVisible();
+            toggleButton->setText(isVisible ? "▼" : "▲");
+            detailsTable->setVisible(!isVisible);
+        });
+
+        layout->addWidget(workoutGroup);
+    }
+}
+
+// Смена дня в списке тренировок. Итерация QBENCHMARK - одно
+// переключение между двумя днями; в замер входят отложенные
+// show/polish и раскладка, то есть всё до готового к отрисовке списка.
+class BenchDaySwitch : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // До: пересборка виджетов карточек
+    void rebuildWidgets_data();
+    void rebuildWidgets();
+    // После: сброс WorkoutListModel, карточки рисует делегат
+    void resetModel_data();
+    void resetModel();
+};
+
+// Тренировок в дне: обычный день, насыщенный и заведомо большой
+static void addDaySizes()
+{
+    QTest::addColumn<int>("perDay");
+    QTest::newRow("3") << 3;
+    QTest::newRow("10") << 10;
+    QTest::newRow("50") << 50;
+}
+
+void BenchDaySwitch::rebuildWidgets_data()
+{
+    addDaySizes();
+}
+
+void BenchDaySwitch::rebuildWidgets()
+{
+    QFETCH(int, perDay);
+    const QVector<WorkoutData> days[2] = {
+        makeDay(QDate(2024, 5, 1), perDay, 1),
+        makeDay(QDate(2024, 5, 2), perDay, perDay + 1)
+    };
+
+    QScrollArea scrollArea;
+    QWidget *container = new QWidget();
+    QVBoxLayout *layout = new QVBoxLayout(container);
+    scrollArea.setWidget(container);
+    scrollArea.setWidgetResizable(true);
+    scrollArea.resize(600, 500);
+    scrollArea.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&scrollArea));
+
+    int current = 0;
+    QBENCHMARK {
+        current ^= 1;
+        rebuildCards(layout, days[current]);
+        layout->activate();
+        QCoreApplication::processEvents();
+    }
+    QCOMPARE(layout->count(), perDay);
+}
+
+void BenchDaySwitch::resetModel_data()
+{
+    addDaySizes();
+}
+
+void BenchDaySwitch::resetModel()
+{
+    QFETCH(int, perDay);
+    const QVector<WorkoutData> days[2] = {
+        makeDay(QDate(2024, 5, 1), perDay, 1),
+        makeDay(QDate(2024, 5, 2), perDay, perDay + 1)
+    };
+
+    WorkoutListModel model;
+    QListView view;
+    view.setModel(&model);
+    view.setItemDelegate(new WorkoutCardDelegate(&view));
+    view.setSelectionMode(QAbstractItemView::NoSelection);
+    view.setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    view.setResizeMode(QListView::Adjust);
+    view.resize(600, 500);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    int current = 0;
+    QBENCHMARK {
+        current ^= 1;
+        model.setWorkouts(days[current]);
+        view.doItemsLayout();
+        QCoreApplication::processEvents();
+    }
+    QCOMPARE(model.rowCount(), perDay);
+}
+
+// Окна нужны настоящие, но без дисплея: по умолчанию offscreen
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    BenchDaySwitch bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "bench_dayswitch.moc"
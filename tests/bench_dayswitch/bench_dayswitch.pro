@@ -0,0 +1,12 @@
+include(../tests.pri)
+
+TARGET = bench_dayswitch
+
+SOURCES += \
+    bench_dayswitch.cpp \
+    $$APP_DIR/workoutlistmodel.cpp \
+    $$APP_DIR/workoutcarddelegate.cpp
+
+HEADERS += \
+    $$APP_DIR/workoutlistmodel.h \
+    $$APP_DIR/workoutcarddelegate.h
@@ -0,0 +1,36 @@
+#ifndef TESTHELPERS_H
+#define TESTHELPERS_H
+
+#include <QDate>
+#include <QString>
+#include "database.h"
+#include "mainwindow.h"
+
+// Общие заготовки данных для тестов и бенчмарков
+
+inline const QString Run = "Бег";
+
+inline WorkoutData makeWorkout(const QDate &date, int duration = 45, int calories = 400,
+                               const QString &type = Run)
+{
+    WorkoutData workout;
+    workout.type = type;
+    workout.date = date;
+    workout.duration = duration;
+    workout.sets = 0;
+    workout.reps = 0;
+    workout.calories = calories;
+    return workout;
+}
+
+inline RollupRow makeRow(const QDate &day, int count, qint64 duration, qint64 calories)
+{
+    RollupRow row;
+    row.period = day;
+    row.count = count;
+    row.duration = duration;
+    row.calories = calories;
+    return row;
+}
+
+#endif // TESTHELPERS_H
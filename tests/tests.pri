@@ -0,0 +1,15 @@
+# Общие настройки тестов: исходники приложения подключаются напрямую
+QT       += core gui sql testlib
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+APP_DIR = $$PWD/..
+INCLUDEPATH += $$APP_DIR
+DEPENDPATH += $$APP_DIR
+
+INCLUDEPATH += $$PWD
+HEADERS += $$PWD/testhelpers.h
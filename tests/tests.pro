@@ -0,0 +1,7 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    bench_database \
+    bench_dayswitch \
+    tst_rangeindex \
+    tst_statsengine
@@ -0,0 +1,264 @@
+#include <QtTest>
+#include <QRandomGenerator>
+#include "rangeindex.h"
+#include "testhelpers.h"
+
+// Суммы снимка за диапазон, границы включительно
+static RangeTotals total(const RangeIndex &index, const QDate &from, const QDate &to)
+{
+    return index.snapshot(Run)->total(from, to);
+}
+
+class TestRangeIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void loadsFromRollups();
+    void boundsAreInclusive();
+    void insertAndRemove();
+    void growsBeforeAndAfter();
+    void emptyTreeGrows();
+    void skipsUpdatesForUnloadedType();
+    void ignoresInvalidDate();
+    void snapshotIsSharedAndImmutable();
+    void revisionNeverRepeats();
+    void matchesBruteForce();
+};
+
+void TestRangeIndex::loadsFromRollups()
+{
+    int loads = 0;
+    RangeIndex index;
+    index.setLoader([&loads](const QString &type) {
+        ++loads;
+        QVector<RollupRow> rows;
+        if (type == Run) {
+            rows.append(makeRow(QDate(2024, 5, 1), 2, 60, 500));
+            rows.append(makeRow(QDate(2024, 5, 3), 1, 45, 300));
+            rows.append(makeRow(QDate(2024, 6, 10), 1, 30, 200));
+        }
+        return rows;
+    });
+
+    const RangeTotals all = total(index, QDate(2024, 1, 1), QDate(2024, 12, 31));
+    QCOMPARE(all.count, 4);
+    QCOMPARE(all.duration, qint64(135));
+    QCOMPARE(all.calories, qint64(1000));
+
+    const RangeTotals may = total(index, QDate(2024, 5, 1), QDate(2024, 5, 31));
+    QCOMPARE(may.count, 3);
+    QCOMPARE(may.duration, qint64(105));
+
+    // Дерево загружается один раз на вид спорта
+    total(index, QDate(2024, 6, 1), QDate(2024, 6, 30));
+    QCOMPARE(loads, 1);
+
+    QCOMPARE(index.snapshot("Йога")->total(QDate(2024, 1, 1), QDate(2024, 12, 31)).count, 0);
+    QCOMPARE(loads, 2);
+}
+
+void TestRangeIndex::boundsAreInclusive()
+{
+    RangeIndex index;
+    index.setLoader([](const QString &) {
+        return QVector<RollupRow>{makeRow(QDate(2024, 5, 1), 1, 10, 100),
+                                  makeRow(QDate(2024, 5, 5), 1, 20, 200)};
+    });
+
+    QCOMPARE(total(index, QDate(2024, 5, 1), QDate(2024, 5, 1)).count, 1);
+    QCOMPARE(total(index, QDate(2024, 5, 5), QDate(2024, 5, 5)).duration, qint64(20));
+    QCOMPARE(total(index, QDate(2024, 5, 2), QDate(2024, 5, 4)).count, 0);
+    QCOMPARE(total(index, QDate(2024, 4, 1), QDate(2024, 4, 30)).count, 0);
+    QCOMPARE(total(index, QDate(2025, 1, 1), QDate(2025, 12, 31)).count, 0);
+    QCOMPARE(total(index, QDate(2024, 4, 1), QDate(2024, 5, 3)).count, 1);
+
+    // Пустой диапазон
+    QCOMPARE(total(index, QDate(2024, 5, 5), QDate(2024, 5, 1)).count, 0);
+}
+
+void TestRangeIndex::insertAndRemove()
+{
+    RangeIndex index;
+    index.setLoader([](const QString &) {
+        return QVector<RollupRow>{makeRow(QDate(2024, 5, 1), 1, 10, 100)};
+    });
+    total(index, QDate(2024, 5, 1), QDate(2024, 5, 1));
+
+    const WorkoutData workout = makeWorkout(QDate(2024, 5, 2), 40, 350);
+    index.insert(workout);
+
+    RangeTotals may = total(index, QDate(2024, 5, 1), QDate(2024, 5, 31));
+    QCOMPARE(may.count, 2);
+    QCOMPARE(may.duration, qint64(50));
+    QCOMPARE(may.calories, qint64(450));
+
+    index.remove(workout);
+    may = total(index, QDate(2024, 5, 1), QDate(2024, 5, 31));
+    QCOMPARE(may.count, 1);
+    QCOMPARE(may.duration, qint64(10));
+    QCOMPARE(may.calories, qint64(100));
+}
+
+void TestRangeIndex::growsBeforeAndAfter()
+{
+    RangeIndex index;
+    index.setLoader([](const QString &) {
+        return QVector<RollupRow>{makeRow(QDate(2024, 5, 1), 1, 10, 100)};
+    });
+    total(index, QDate(2024, 5, 1), QDate(2024, 5, 1));
+
+    // Далеко за пределами запаса с обеих сторон
+    index.insert(makeWorkout(QDate(2019, 3, 10), 20, 200));
+    index.insert(makeWorkout(QDate(2030, 8, 20), 30, 300));
+
+    QCOMPARE(total(index, QDate(2019, 3, 10), QDate(2019, 3, 10)).count, 1);
+    QCOMPARE(total(index, QDate(2024, 5, 1), QDate(2024, 5, 1)).duration, qint64(10));
+    QCOMPARE(total(index, QDate(2030, 8, 20), QDate(2030, 8, 20)).calories, qint64(300));
+
+    const RangeTotals all = total(index, QDate(2000, 1, 1), QDate(2040, 1, 1));
+    QCOMPARE(all.count, 3);
+    QCOMPARE(all.duration, qint64(60));
+    QCOMPARE(all.calories, qint64(600));
+}
+
+void TestRangeIndex::emptyTreeGrows()
+{
+    RangeIndex index;
+    index.setLoader([](const QString &) { return QVector<RollupRow>(); });
+    QCOMPARE(total(index, QDate(2024, 1, 1), QDate(2024, 12, 31)).count, 0);
+
+    index.insert(makeWorkout(QDate(2024, 7, 7), 25, 250));
+    index.insert(makeWorkout(QDate(2024, 7, 1), 15, 150));
+
+    const RangeTotals july = total(index, QDate(2024, 7, 1), QDate(2024, 7, 31));
+    QCOMPARE(july.count, 2);
+    QCOMPARE(july.duration, qint64(40));
+}
+
+void TestRangeIndex::skipsUpdatesForUnloadedType()
+{
+    RangeIndex index;
+    index.setLoader([](const QString &) {
+        return QVector<RollupRow>{makeRow(QDate(2024, 5, 1), 1, 10, 100)};
+    });
+
+    // Дерево ещё не загружено: изменение уже есть в сводке, которую вернёт загрузчик
+    index.insert(makeWorkout(QDate(2024, 5, 1), 10, 100));
+
+    QCOMPARE(total(index, QDate(2024, 5, 1), QDate(2024, 5, 1)).count, 1);
+}
+
+void TestRangeIndex::ignoresInvalidDate()
+{
+    RangeIndex index;
+    index.setLoader([](const QString &) {
+        return QVector<RollupRow>{makeRow(QDate(2024, 5, 1), 1, 10, 100)};
+    });
+    total(index, QDate(2024, 5, 1), QDate(2024, 5, 1));
+
+    index.insert(makeWorkout(QDate(), 10, 100));
+
+    QCOMPARE(total(index, QDate(2000, 1, 1), QDate(2040, 1, 1)).count, 1);
+}
+
+void TestRangeIndex::snapshotIsSharedAndImmutable()
+{
+    RangeIndex index;
+    index.setLoader([](const QString &) {
+        return QVector<RollupRow>{makeRow(QDate(2024, 5, 1), 1, 10, 100)};
+    });
+
+    const RangeSnapshotPtr first = index.snapshot(Run);
+    const RangeSnapshotPtr second = index.snapshot(Run);
+    QCOMPARE(first.data(), second.data());
+
+    index.insert(makeWorkout(QDate(2024, 5, 2), 20, 200));
+
+    // Старый снимок не видит изменения, новый - видит
+    QCOMPARE(first->total(QDate(2024, 5, 1), QDate(2024, 5, 31)).count, 1);
+    const RangeSnapshotPtr third = index.snapshot(Run);
+    QVERIFY(third.data() != first.data());
+    QCOMPARE(third->total(QDate(2024, 5, 1), QDate(2024, 5, 31)).count, 2);
+    QVERIFY(third->revision() > first->revision());
+}
+
+void TestRangeIndex::revisionNeverRepeats()
+{
+    RangeIndex index;
+    index.setLoader([](const QString &) {
+        return QVector<RollupRow>{makeRow(QDate(2024, 5, 1), 1, 10, 100)};
+    });
+
+    QCOMPARE(index.revision(Run), quint64(0));
+
+    const RangeSnapshotPtr loaded = index.snapshot(Run);
+    QVERIFY(loaded->revision() > 0);
+    QCOMPARE(index.revision(Run), loaded->revision());
+
+    index.insert(makeWorkout(QDate(2024, 5, 2), 20, 200));
+    QVERIFY(index.revision(Run) > loaded->revision());
+
+    const quint64 beforeClear = index.revision(Run);
+    index.clear();
+    QCOMPARE(index.revision(Run), quint64(0));
+
+    const RangeSnapshotPtr reloaded = index.snapshot(Run);
+    QVERIFY(reloaded->revision() > beforeClear);
+}
+
+void TestRangeIndex::matchesBruteForce()
+{
+    // Случайные вставки и удаления сверяются с прямым суммированием по дням
+    const QDate firstDay(2023, 1, 1);
+    const int days = 800;
+
+    QVector<RollupRow> rows;
+    QVector<RangeTotals> expected(days);
+    QRandomGenerator random(12345);
+    for (int day = 0; day < days; day += 3) {
+        const int duration = random.bounded(10, 120);
+        const int calories = random.bounded(50, 900);
+        rows.append(makeRow(firstDay.addDays(day), 1, duration, calories));
+        expected[day] += {1, duration, calories};
+    }
+
+    RangeIndex index;
+    index.setLoader([rows](const QString &) { return rows; });
+    total(index, firstDay, firstDay);
+
+    QVector<WorkoutData> inserted;
+    for (int i = 0; i < 2000; ++i) {
+        if (!inserted.isEmpty() && random.bounded(3) == 0) {
+            const WorkoutData workout = inserted.takeAt(random.bounded(int(inserted.size())));
+            index.remove(workout);
+            expected[firstDay.daysTo(workout.date)] -= {1, workout.duration, workout.calories};
+        } else {
+            const WorkoutData workout = makeWorkout(firstDay.addDays(random.bounded(days)),
+                                                    random.bounded(10, 120), random.bounded(50, 900));
+            index.insert(workout);
+            inserted.append(workout);
+            expected[firstDay.daysTo(workout.date)] += {1, workout.duration, workout.calories};
+        }
+    }
+
+    const RangeSnapshotPtr snapshot = index.snapshot(Run);
+    for (int i = 0; i < 500; ++i) {
+        const int from = random.bounded(days);
+        const int to = from + random.bounded(days - from);
+
+        RangeTotals sum;
+        for (int day = from; day <= to; ++day) {
+            sum += expected[day];
+        }
+
+        const RangeTotals actual = snapshot->total(firstDay.addDays(from), firstDay.addDays(to));
+        QCOMPARE(actual.count, sum.count);
+        QCOMPARE(actual.duration, sum.duration);
+        QCOMPARE(actual.calories, sum.calories);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestRangeIndex)
+
+#include "tst_rangeindex.moc"
@@ -0,0 +1,10 @@
+include(../tests.pri)
+
+TARGET = tst_rangeindex
+
+SOURCES += \
+    tst_rangeindex.cpp \
+    $$APP_DIR/rangeindex.cpp
+
+HEADERS += \
+    $$APP_DIR/rangeindex.h
@@ -0,0 +1,322 @@
+#include <QtTest>
+#include <QRandomGenerator>
+#include "statsengine.h"
+#include "rangeindex.h"
+#include "testhelpers.h"
+
+Q_DECLARE_METATYPE(StatsPeriod)
+
+// Индекс с уже загруженным пустым деревом, чтобы вставки применялись
+static void prepareIndex(RangeIndex &index)
+{
+    index.setLoader([](const QString &) { return QVector<RollupRow>(); });
+    index.snapshot(Run);
+}
+
+static QVector<QDate> toDates(const QVector<int> &days)
+{
+    QVector<QDate> dates;
+    for (int day : days) {
+        dates.append(QDate::fromJulianDay(day));
+    }
+    return dates;
+}
+
+class TestStatsEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void periodRange_data();
+    void periodRange();
+    void bucketBoundaries_data();
+    void bucketBoundaries();
+    void aggregateMonthClampsEdgeWeeks();
+    void aggregateYear();
+    void aggregateEmpty();
+    void bucketMeans();
+    void downsampleKeepsShortSeries();
+    void downsampleKeepsShape();
+
+    void benchmarkInsert1M();
+    void benchmarkAggregate1M_data();
+    void benchmarkAggregate1M();
+
+private:
+    RangeIndex m_bigIndex;
+    bool m_bigIndexReady = false;
+};
+
+void TestStatsEngine::periodRange_data()
+{
+    QTest::addColumn<StatsPeriod>("period");
+    QTest::addColumn<int>("shift");
+    QTest::addColumn<QDate>("today");
+    QTest::addColumn<QDate>("start");
+    QTest::addColumn<QDate>("end");
+
+    QTest::newRow("week") << StatsPeriod::Week << 0 << QDate(2024, 5, 15)
+                          << QDate(2024, 5, 13) << QDate(2024, 5, 19);
+    QTest::newRow("previous week") << StatsPeriod::Week << -1 << QDate(2024, 5, 15)
+                                   << QDate(2024, 5, 6) << QDate(2024, 5, 12);
+    QTest::newRow("week across new year") << StatsPeriod::Week << 0 << QDate(2025, 1, 1)
+                                          << QDate(2024, 12, 30) << QDate(2025, 1, 5);
+    QTest::newRow("leap february") << StatsPeriod::Month << 0 << QDate(2024, 2, 15)
+                                   << QDate(2024, 2, 1) << QDate(2024, 2, 29);
+    QTest::newRow("month back over year") << StatsPeriod::Month << -2 << QDate(2024, 1, 31)
+                                          << QDate(2023, 11, 1) << QDate(2023, 11, 30);
+    QTest::newRow("next year") << StatsPeriod::Year << 1 << QDate(2024, 5, 15)
+                               << QDate(2025, 1, 1) << QDate(2025, 12, 31);
+    QTest::newRow("90 days") << StatsPeriod::Last90Days << 0 << QDate(2024, 5, 15)
+                             << QDate(2024, 2, 16) << QDate(2024, 5, 15);
+    QTest::newRow("previous 90 days") << StatsPeriod::Last90Days << -1 << QDate(2024, 5, 15)
+                                      << QDate(2023, 11, 18) << QDate(2024, 2, 15);
+}
+
+void TestStatsEngine::periodRange()
+{
+    QFETCH(StatsPeriod, period);
+    QFETCH(int, shift);
+    QFETCH(QDate, today);
+    QFETCH(QDate, start);
+    QFETCH(QDate, end);
+
+    QDate actualStart, actualEnd;
+    StatsEngine::periodRange(period, shift, today, actualStart, actualEnd);
+    QCOMPARE(actualStart, start);
+    QCOMPARE(actualEnd, end);
+}
+
+void TestStatsEngine::bucketBoundaries_data()
+{
+    QTest::addColumn<StatsPeriod>("period");
+    QTest::addColumn<QDate>("start");
+    QTest::addColumn<QDate>("end");
+    QTest::addColumn<QVector<QDate>>("expected");
+
+    QVector<QDate> week;
+    for (int i = 0; i <= 7; ++i) {
+        week.append(QDate(2024, 5, 13).addDays(i));
+    }
+    QTest::newRow("week") << StatsPeriod::Week << QDate(2024, 5, 13) << QDate(2024, 5, 19) << week;
+
+    QVector<QDate> days90;
+    for (int i = 0; i <= 90; ++i) {
+        days90.append(QDate(2024, 2, 16).addDays(i));
+    }
+    QTest::newRow("90 days") << StatsPeriod::Last90Days << QDate(2024, 2, 16) << QDate(2024, 5, 15) << days90;
+
+    // Май 2024 начинается в среду: первая неделя - с понедельника 29 апреля
+    QTest::newRow("month from wednesday") << StatsPeriod::Month << QDate(2024, 5, 1) << QDate(2024, 5, 31)
+        << QVector<QDate>{QDate(2024, 4, 29), QDate(2024, 5, 6), QDate(2024, 5, 13),
+                          QDate(2024, 5, 20), QDate(2024, 5, 27), QDate(2024, 6, 3)};
+
+    QTest::newRow("month from monday") << StatsPeriod::Month << QDate(2024, 7, 1) << QDate(2024, 7, 31)
+        << QVector<QDate>{QDate(2024, 7, 1), QDate(2024, 7, 8), QDate(2024, 7, 15),
+                          QDate(2024, 7, 22), QDate(2024, 7, 29), QDate(2024, 8, 5)};
+
+    // Последняя ISO-неделя декабря заканчивается в следующем году
+    QTest::newRow("month across new year") << StatsPeriod::Month << QDate(2024, 12, 1) << QDate(2024, 12, 31)
+        << QVector<QDate>{QDate(2024, 11, 25), QDate(2024, 12, 2), QDate(2024, 12, 9),
+                          QDate(2024, 12, 16), QDate(2024, 12, 23), QDate(2024, 12, 30),
+                          QDate(2025, 1, 6)};
+
+    QVector<QDate> year;
+    for (int month = 1; month <= 12; ++month) {
+        year.append(QDate(2024, month, 1));
+    }
+    year.append(QDate(2025, 1, 1));
+    QTest::newRow("year") << StatsPeriod::Year << QDate(2024, 1, 1) << QDate(2024, 12, 31) << year;
+}
+
+void TestStatsEngine::bucketBoundaries()
+{
+    QFETCH(StatsPeriod, period);
+    QFETCH(QDate, start);
+    QFETCH(QDate, end);
+    QFETCH(QVector<QDate>, expected);
+
+    QCOMPARE(toDates(StatsEngine::bucketBoundaries(period, start, end)), expected);
+}
+
+void TestStatsEngine::aggregateMonthClampsEdgeWeeks()
+{
+    RangeIndex index;
+    prepareIndex(index);
+
+    // 30 апреля и 1 июня попадают в крайние недели, но не в месяц
+    index.insert(makeWorkout(QDate(2024, 4, 30), 100, 1000));
+    index.insert(makeWorkout(QDate(2024, 5, 1), 30, 300));
+    index.insert(makeWorkout(QDate(2024, 5, 14), 40, 400));
+    index.insert(makeWorkout(QDate(2024, 5, 15), 60, 500));
+    index.insert(makeWorkout(QDate(2024, 5, 31), 50, 450));
+    index.insert(makeWorkout(QDate(2024, 6, 1), 100, 1000));
+
+    const StatsResult result = StatsEngine::aggregate(StatsPeriod::Month, QDate(2024, 5, 1),
+                                                      QDate(2024, 5, 31), *index.snapshot(Run));
+
+    QCOMPARE(result.buckets.size(), qsizetype(3));
+
+    const StatsBucket &first = result.buckets.at(0);
+    QCOMPARE(first.index, 0);
+    QCOMPARE(first.start, QDate(2024, 5, 1));
+    QCOMPARE(first.end, QDate(2024, 5, 5));
+    QCOMPARE(first.count, 1);
+    QCOMPARE(first.totalDuration, 30.0);
+
+    const StatsBucket &middle = result.buckets.at(1);
+    QCOMPARE(middle.index, 2);
+    QCOMPARE(middle.start, QDate(2024, 5, 13));
+    QCOMPARE(middle.end, QDate(2024, 5, 19));
+    QCOMPARE(middle.count, 2);
+    QCOMPARE(middle.totalCalories, 900.0);
+
+    const StatsBucket &last = result.buckets.at(2);
+    QCOMPARE(last.index, 4);
+    QCOMPARE(last.start, QDate(2024, 5, 27));
+    QCOMPARE(last.end, QDate(2024, 5, 31));
+    QCOMPARE(last.count, 1);
+
+    // Столбцы и итог считаются по одним и тем же дням
+    QCOMPARE(result.summary.count, 4);
+    QCOMPARE(result.summary.totalDuration, 180.0);
+    QCOMPARE(result.summary.totalCalories, 1650.0);
+}
+
+void TestStatsEngine::aggregateYear()
+{
+    RangeIndex index;
+    prepareIndex(index);
+
+    index.insert(makeWorkout(QDate(2023, 12, 31), 100, 1000));
+    index.insert(makeWorkout(QDate(2024, 1, 1), 30, 300));
+    index.insert(makeWorkout(QDate(2024, 1, 31), 50, 200));
+    index.insert(makeWorkout(QDate(2024, 12, 31), 20, 100));
+    index.insert(makeWorkout(QDate(2025, 1, 1), 100, 1000));
+
+    const StatsResult result = StatsEngine::aggregate(StatsPeriod::Year, QDate(2024, 1, 1),
+                                                      QDate(2024, 12, 31), *index.snapshot(Run));
+
+    QCOMPARE(result.buckets.size(), qsizetype(2));
+    QCOMPARE(result.buckets.at(0).index, 0);
+    QCOMPARE(result.buckets.at(0).start, QDate(2024, 1, 1));
+    QCOMPARE(result.buckets.at(0).end, QDate(2024, 1, 31));
+    QCOMPARE(result.buckets.at(0).count, 2);
+    QCOMPARE(result.buckets.at(1).index, 11);
+    QCOMPARE(result.buckets.at(1).end, QDate(2024, 12, 31));
+    QCOMPARE(result.summary.count, 3);
+    QCOMPARE(result.summary.totalDuration, 100.0);
+}
+
+void TestStatsEngine::aggregateEmpty()
+{
+    RangeIndex index;
+    prepareIndex(index);
+
+    const StatsResult result = StatsEngine::aggregate(StatsPeriod::Week, QDate(2024, 5, 13),
+                                                      QDate(2024, 5, 19), *index.snapshot(Run));
+    QCOMPARE(int(result.period), int(StatsPeriod::Week));
+    QCOMPARE(result.start, QDate(2024, 5, 13));
+    QCOMPARE(result.end, QDate(2024, 5, 19));
+    QVERIFY(result.buckets.isEmpty());
+    QCOMPARE(result.summary.count, 0);
+}
+
+void TestStatsEngine::bucketMeans()
+{
+    StatsBucket bucket;
+    QCOMPARE(bucket.meanDuration(), 0.0);
+    QCOMPARE(bucket.intensity(), 0.0);
+
+    bucket.count = 4;
+    bucket.totalDuration = 200;
+    bucket.totalCalories = 1000;
+    QCOMPARE(bucket.meanDuration(), 50.0);
+    QCOMPARE(bucket.meanCalories(), 250.0);
+    QCOMPARE(bucket.intensity(), 5.0);
+}
+
+void TestStatsEngine::downsampleKeepsShortSeries()
+{
+    QCOMPARE(StatsEngine::downsample({}, 10), QVector<int>());
+    QCOMPARE(StatsEngine::downsample({1, 2, 3, 4, 5}, 10), (QVector<int>{0, 1, 2, 3, 4}));
+
+    // Порог меньше трёх точек поднимается до трёх
+    QCOMPARE(StatsEngine::downsample({1, 2, 3, 4, 5}, 2), (QVector<int>{0, 1, 4}));
+}
+
+void TestStatsEngine::downsampleKeepsShape()
+{
+    QVector<double> values(1000, 0.0);
+    values[500] = 100;
+
+    const QVector<int> indices = StatsEngine::downsample(values, 10);
+    QCOMPARE(indices.size(), qsizetype(10));
+    QCOMPARE(indices.first(), 0);
+    QCOMPARE(indices.last(), 999);
+    QVERIFY(indices.contains(500));
+    for (int i = 1; i < indices.size(); ++i) {
+        QVERIFY(indices.at(i) > indices.at(i - 1));
+    }
+}
+
+void TestStatsEngine::benchmarkInsert1M()
+{
+    // Миллион тренировок за десять лет, по одной точечной вставке
+    QVector<WorkoutData> workouts;
+    workouts.reserve(1000000);
+    QRandomGenerator random(2024);
+    const QDate firstDay(2015, 1, 1);
+    for (int i = 0; i < 1000000; ++i) {
+        workouts.append(makeWorkout(firstDay.addDays(random.bounded(3650)),
+                                    random.bounded(10, 120), random.bounded(50, 900)));
+    }
+
+    QBENCHMARK_ONCE {
+        RangeIndex index;
+        prepareIndex(index);
+        for (const WorkoutData &workout : workouts) {
+            index.insert(workout);
+        }
+    }
+}
+
+void TestStatsEngine::benchmarkAggregate1M_data()
+{
+    QTest::addColumn<StatsPeriod>("period");
+
+    QTest::newRow("week") << StatsPeriod::Week;
+    QTest::newRow("month") << StatsPeriod::Month;
+    QTest::newRow("year") << StatsPeriod::Year;
+    QTest::newRow("90 days") << StatsPeriod::Last90Days;
+}
+
+void TestStatsEngine::benchmarkAggregate1M()
+{
+    QFETCH(StatsPeriod, period);
+
+    if (!m_bigIndexReady) {
+        prepareIndex(m_bigIndex);
+        QRandomGenerator random(2024);
+        const QDate firstDay(2015, 1, 1);
+        for (int i = 0; i < 1000000; ++i) {
+            m_bigIndex.insert(makeWorkout(firstDay.addDays(random.bounded(3650)),
+                                          random.bounded(10, 120), random.bounded(50, 900)));
+        }
+        m_bigIndexReady = true;
+    }
+
+    QDate start, end;
+    StatsEngine::periodRange(period, 0, QDate(2020, 6, 15), start, end);
+    const RangeSnapshotPtr snapshot = m_bigIndex.snapshot(Run);
+
+    StatsResult result;
+    QBENCHMARK {
+        result = StatsEngine::aggregate(period, start, end, *snapshot);
+    }
+    QVERIFY(result.summary.count > 0);
+}
+
+QTEST_APPLESS_MAIN(TestStatsEngine)
+
+#include "tst_statsengine.moc"
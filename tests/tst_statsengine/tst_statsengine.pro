@@ -0,0 +1,12 @@
+include(../tests.pri)
+
+TARGET = tst_statsengine
+
+SOURCES += \
+    tst_statsengine.cpp \
+    $$APP_DIR/rangeindex.cpp \
+    $$APP_DIR/statsengine.cpp
+
+HEADERS += \
+    $$APP_DIR/rangeindex.h \
+    $$APP_DIR/statsengine.h
@@ -0,0 +1,34 @@
+#include "theme.h"
+#include <QApplication>
+#include <QWidget>
+#include <QStyle>
+#include <QFile>
+#include <QDebug>
+
+static const char *StyleSheetPath = ":/theme/theme.qss";
+
+bool Theme::apply(QApplication &app)
+{
+    // Стиль задаётся один раз: смена стиля заново полирует все виджеты
+    QApplication::setStyle("Fusion");
+
+    QFile file(StyleSheetPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Failed to load stylesheet:" << file.errorString();
+        return false;
+    }
+
+    app.setStyleSheet(QString::fromUtf8(file.readAll()));
+    return true;
+}
+
+void Theme::setVariant(QWidget *widget, const QString &variant)
+{
+    widget->setProperty("variant", variant);
+
+    // Уже отрисованный виджет сам не пересчитает стиль по новому свойству
+    if (widget->testAttribute(Qt::WA_WState_Polished)) {
+        widget->style()->unpolish(widget);
+        widget->style()->polish(widget);
+    }
+}
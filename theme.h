@@ -0,0 +1,21 @@
+#ifndef THEME_H
+#define THEME_H
+
+#include <QString>
+
+class QApplication;
+class QWidget;
+
+// Оформление приложения: стиль Fusion и одна таблица стилей из ресурса
+// :/theme/theme.qss задаются QApplication при запуске, поэтому разбираются один раз.
+// Виджеты выбираются в ней по objectName и свойству variant.
+class Theme
+{
+public:
+    static bool apply(QApplication &app);
+
+    // Назначает виджету общую роль оформления (свойство variant)
+    static void setVariant(QWidget *widget, const QString &variant);
+};
+
+#endif // THEME_H
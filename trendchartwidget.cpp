@@ -0,0 +1,260 @@
+#include "trendchartwidget.h"
+#include "statsengine.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QFontMetrics>
+#include <cmath>
+
+// Минимальный шаг между точками и ширина точки с подписью, px
+static const int PixelsPerPoint = 40;
+static const int PixelsPerLabel = 80;
+
+// Поля вокруг области построения, px
+static const int LeftMargin = 60;
+static const int RightMargin = 20;
+static const int TopMargin = 20;
+static const int BottomMargin = 50;
+
+static const int GridLines = 5;
+
+TrendChartWidget::TrendChartWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+}
+
+void TrendChartWidget::setColor(const QColor &color)
+{
+    m_color = color;
+    update();
+}
+
+void TrendChartWidget::setAxisTitle(const QString &title)
+{
+    m_axisTitle = title;
+    m_backgroundDirty = true;
+    update();
+}
+
+void TrendChartWidget::setUnit(const QString &unit)
+{
+    m_unit = unit;
+    update();
+}
+
+void TrendChartWidget::setRotatedLabels(bool rotated)
+{
+    if (m_rotatedLabels == rotated) return;
+    m_rotatedLabels = rotated;
+    m_backgroundDirty = true;
+    update();
+}
+
+void TrendChartWidget::setData(const QStringList &categories, const QVector<double> &values)
+{
+    m_categories = categories;
+    m_values = values;
+    updateRange();
+    updateLayout();
+}
+
+void TrendChartWidget::clear()
+{
+    setData(QStringList(), QVector<double>());
+}
+
+QSize TrendChartWidget::sizeHint() const
+{
+    return QSize(600, 300);
+}
+
+QSize TrendChartWidget::minimumSizeHint() const
+{
+    return QSize(300, 300);
+}
+
+void TrendChartWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    updateLayout();
+}
+
+QRectF TrendChartWidget::plotRect() const
+{
+    return QRectF(LeftMargin, TopMargin,
+                  qMax(1, width() - LeftMargin - RightMargin),
+                  qMax(1, height() - TopMargin - BottomMargin));
+}
+
+void TrendChartWidget::updateRange()
+{
+    if (m_values.isEmpty()) {
+        m_minY = 0;
+        m_maxY = 1;
+        m_stepY = 1.0 / GridLines;
+        return;
+    }
+
+    double minVal = m_values.first();
+    double maxVal = m_values.first();
+    for (double value : m_values) {
+        minVal = qMin(minVal, value);
+        maxVal = qMax(maxVal, value);
+    }
+
+    // Как прежде: запас 10% от размаха, ось не уходит ниже нуля
+    double low, high;
+    const double range = maxVal - minVal;
+    if (range < 0.1) {
+        low = 0;
+        high = maxVal > 0 ? maxVal * 1.5 : 1;
+    } else {
+        low = qMax(0.0, minVal - range * 0.1);
+        high = maxVal + range * 0.1;
+    }
+
+    // Круглый шаг сетки: 1, 2 или 5 на степень десяти
+    const double rawStep = (high - low) / GridLines;
+    const double magnitude = std::pow(10.0, std::floor(std::log10(rawStep)));
+    const double fraction = rawStep / magnitude;
+    const double niceFraction = fraction <= 1 ? 1 : fraction <= 2 ? 2 : fraction <= 5 ? 5 : 10;
+
+    m_stepY = niceFraction * magnitude;
+    m_minY = std::floor(low / m_stepY) * m_stepY;
+    m_maxY = std::ceil(high / m_stepY) * m_stepY;
+    if (m_maxY <= m_minY) {
+        m_maxY = m_minY + m_stepY;
+    }
+}
+
+void TrendChartWidget::updateLayout()
+{
+    const QRectF plot = plotRect();
+
+    // Число точек ограничено шириной области построения
+    m_shown = StatsEngine::downsample(m_values, int(plot.width()) / PixelsPerPoint);
+    m_showPointLabels = m_shown.size() * PixelsPerLabel <= plot.width();
+
+    m_points.clear();
+    m_points.reserve(m_shown.size());
+
+    // Точка - в центре своей категории
+    const double slot = plot.width() / qMax<qsizetype>(1, m_shown.size());
+    for (int i = 0; i < m_shown.size(); ++i) {
+        const double value = m_values[m_shown[i]];
+        const double x = plot.left() + slot * (i + 0.5);
+        const double y = plot.bottom() - (value - m_minY) / (m_maxY - m_minY) * plot.height();
+        m_points.append(QPointF(x, y));
+    }
+
+    m_backgroundDirty = true;
+    update();
+}
+
+void TrendChartWidget::renderBackground()
+{
+    const qreal ratio = devicePixelRatioF();
+    m_background = QPixmap(size() * ratio);
+    m_background.setDevicePixelRatio(ratio);
+    m_background.fill(Qt::white);
+
+    QPainter painter(&m_background);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+
+    QFont labelFont = font();
+    labelFont.setPointSize(8);
+    painter.setFont(labelFont);
+    const QFontMetrics metrics(labelFont);
+
+    const QRectF plot = plotRect();
+
+    // Горизонтальная сетка и подписи оси Y
+    for (double value = m_minY; value <= m_maxY + m_stepY / 2; value += m_stepY) {
+        const double y = plot.bottom() - (value - m_minY) / (m_maxY - m_minY) * plot.height();
+        painter.setPen(QPen(QColor("#e0e0e0"), 1));
+        painter.drawLine(QPointF(plot.left(), y), QPointF(plot.right(), y));
+
+        painter.setPen(QColor("#555"));
+        painter.drawText(QRectF(0, y - metrics.height() / 2.0, LeftMargin - 6, metrics.height()),
+                         Qt::AlignRight | Qt::AlignVCenter, QString::number(value, 'f', 1));
+    }
+
+    // Оси
+    painter.setPen(QPen(QColor("#888"), 1));
+    painter.drawLine(plot.bottomLeft(), plot.bottomRight());
+    painter.drawLine(plot.bottomLeft(), plot.topLeft());
+
+    // Название оси Y
+    if (!m_axisTitle.isEmpty()) {
+        painter.save();
+        painter.setPen(QColor("#555"));
+        painter.translate(12, plot.center().y());
+        painter.rotate(-90);
+        painter.drawText(QRectF(-plot.height() / 2, -metrics.height() / 2.0, plot.height(), metrics.height()),
+                         Qt::AlignCenter, m_axisTitle);
+        painter.restore();
+    }
+
+    // Подписи категорий под видимыми точками
+    painter.setPen(QColor("#555"));
+    const double slot = plot.width() / qMax<qsizetype>(1, m_shown.size());
+    for (int i = 0; i < m_shown.size(); ++i) {
+        const QString label = m_categories.value(m_shown[i]);
+        const QPointF anchor(m_points[i].x(), plot.bottom() + 4);
+
+        if (m_rotatedLabels) {
+            painter.save();
+            painter.translate(anchor);
+            painter.rotate(-45);
+            painter.drawText(QPointF(-metrics.horizontalAdvance(label), metrics.ascent()), label);
+            painter.restore();
+        } else {
+            painter.drawText(QRectF(anchor.x() - slot / 2, anchor.y(), slot, metrics.height()),
+                             Qt::AlignHCenter | Qt::AlignTop, label);
+        }
+    }
+
+    m_backgroundDirty = false;
+}
+
+void TrendChartWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    if (m_backgroundDirty || m_background.size() != size() * devicePixelRatioF()) {
+        renderBackground();
+    }
+
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, m_background);
+    if (m_points.isEmpty()) return;
+
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // Линия и точки
+    painter.setPen(QPen(m_color, 2));
+    painter.drawPolyline(m_points);
+
+    painter.setBrush(m_color);
+    for (const QPointF &point : m_points) {
+        painter.drawEllipse(point, 3, 3);
+    }
+
+    // Подписи значений - только если точки редкие
+    if (!m_showPointLabels) return;
+
+    QFont labelFont = font();
+    labelFont.setPointSize(8);
+    painter.setFont(labelFont);
+    painter.setPen(m_color.darker());
+
+    const QFontMetrics metrics(labelFont);
+    for (int i = 0; i < m_points.size(); ++i) {
+        const QString label = QString("%1 %2").arg(m_values[m_shown[i]]).arg(m_unit);
+        const QPointF &point = m_points[i];
+        painter.drawText(QPointF(point.x() - metrics.horizontalAdvance(label) / 2.0, point.y() - 6), label);
+    }
+}
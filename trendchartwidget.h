@@ -0,0 +1,67 @@
+#ifndef TRENDCHARTWIDGET_H
+#define TRENDCHARTWIDGET_H
+
+#include <QWidget>
+#include <QPixmap>
+#include <QPolygonF>
+#include <QStringList>
+#include <QVector>
+#include <QColor>
+
+// Линейный график ряда значений, нарисованный напрямую через QPainter.
+//
+// Сетка, оси и подписи осей рисуются в QPixmap и перерисовываются
+// только при смене данных или размера; в paintEvent поверх него
+// рисуется линия. Ряд прореживается под ширину виджета, поэтому
+// стоимость отрисовки не зависит от длины истории.
+class TrendChartWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TrendChartWidget(QWidget *parent = nullptr);
+
+    void setColor(const QColor &color);
+    void setAxisTitle(const QString &title);
+    void setUnit(const QString &unit);
+    void setRotatedLabels(bool rotated);
+
+    void setData(const QStringList &categories, const QVector<double> &values);
+    void clear();
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    void updateLayout();
+    void updateRange();
+    void renderBackground();
+    QRectF plotRect() const;
+
+    QColor m_color = QColor("#4285F4");
+    QString m_axisTitle;
+    QString m_unit;
+    bool m_rotatedLabels = false;
+
+    // Полный ряд
+    QStringList m_categories;
+    QVector<double> m_values;
+
+    // Видимые точки после прореживания
+    QVector<int> m_shown;
+    QPolygonF m_points;
+    bool m_showPointLabels = false;
+
+    double m_minY = 0;
+    double m_maxY = 1;
+    double m_stepY = 1;
+
+    QPixmap m_background;
+    bool m_backgroundDirty = true;
+};
+
+#endif // TRENDCHARTWIDGET_H
@@ -0,0 +1,162 @@
+#include "workoutcarddelegate.h"
+#include "workoutlistmodel.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QMouseEvent>
+#include <QAbstractScrollArea>
+
+// Размеры карточки, px
+static const int CardSpacing = 5;       // отступ сверху и снизу карточки
+static const int HeaderHeight = 40;
+static const int DetailRowHeight = 26;
+static const int DetailRows = 4;
+static const int DetailPadding = 6;
+static const int LabelWidth = 120;
+static const int TextInset = 10;        // отступ текста внутри таблицы
+
+WorkoutCardDelegate::WorkoutCardDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+QRectF WorkoutCardDelegate::cardRect(const QRect &itemRect) const
+{
+    return QRectF(itemRect).adjusted(1, CardSpacing, -1, -CardSpacing);
+}
+
+QRectF WorkoutCardDelegate::headerRect(const QRect &itemRect) const
+{
+    const QRectF card = cardRect(itemRect);
+    return QRectF(card.left(), card.top(), card.width(), HeaderHeight);
+}
+
+int WorkoutCardDelegate::notesHeight(const QStyleOptionViewItem &option, const QString &notes,
+                                     qreal cardWidth) const
+{
+    if (notes.isEmpty()) return 0;
+
+    // Заметки переносятся по словам в колонке значений
+    const int textWidth = qMax(1, int(cardWidth) - 2 * DetailPadding - 2 * TextInset - LabelWidth);
+    const QRect bounds = option.fontMetrics.boundingRect(QRect(0, 0, textWidth, 100000),
+                                                         Qt::TextWordWrap, notes);
+    return qMax(DetailRowHeight, bounds.height() + 8);
+}
+
+QSize WorkoutCardDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    // Ширина строки - ширина области просмотра списка
+    int width = option.rect.width();
+    if (const QAbstractScrollArea *view = qobject_cast<const QAbstractScrollArea*>(option.widget)) {
+        width = view->viewport()->width();
+    }
+
+    int height = HeaderHeight + 2 * CardSpacing;
+    if (index.data(WorkoutListModel::ExpandedRole).toBool()) {
+        const QString notes = index.data(WorkoutListModel::NotesRole).toString();
+        height += DetailRows * DetailRowHeight + 3 * DetailPadding
+                + notesHeight(option, notes, cardRect(QRect(0, 0, width, 0)).width());
+    }
+    return QSize(width, height);
+}
+
+void WorkoutCardDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                                const QModelIndex &index) const
+{
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    const QRectF card = cardRect(option.rect);
+    const bool expanded = index.data(WorkoutListModel::ExpandedRole).toBool();
+
+    // Рамка карточки
+    painter->setPen(QPen(QColor("#c0c0c0"), 1));
+    painter->setBrush(option.palette.base());
+    painter->drawRoundedRect(card, 6, 6);
+
+    // Заголовок: тип, сводка и стрелка
+    const QRectF header = headerRect(option.rect).adjusted(10, 0, -10, 0);
+
+    QFont titleFont = option.font;
+    titleFont.setPixelSize(14);
+    titleFont.setBold(true);
+    painter->setFont(titleFont);
+    painter->setPen(option.palette.text().color());
+
+    const QString title = index.data(WorkoutListModel::TypeRole).toString();
+    const int titleWidth = QFontMetrics(titleFont).horizontalAdvance(title);
+    painter->drawText(header, Qt::AlignLeft | Qt::AlignVCenter, title);
+
+    painter->setFont(option.font);
+    painter->setPen(QColor("#666"));
+    const QString summary = QString("%1 мин · %2 подх.")
+        .arg(index.data(WorkoutListModel::DurationRole).toInt())
+        .arg(index.data(WorkoutListModel::SetsRole).toInt());
+    painter->drawText(header.adjusted(titleWidth + 10, 0, -24, 0), Qt::AlignLeft | Qt::AlignVCenter, summary);
+
+    painter->setPen(option.palette.text().color());
+    painter->drawText(header, Qt::AlignRight | Qt::AlignVCenter, expanded ? "▲" : "▼");
+
+    // Таблица деталей; заметки к этому моменту загружены моделью
+    if (expanded) {
+        const QString notes = index.data(WorkoutListModel::NotesRole).toString();
+        const int notesBlock = notesHeight(option, notes, card.width());
+
+        const QRectF details(card.left() + DetailPadding, card.top() + HeaderHeight,
+                             card.width() - 2 * DetailPadding,
+                             DetailRows * DetailRowHeight + notesBlock + 2 * DetailPadding);
+        painter->setPen(QPen(QColor("#c0c0c0"), 1));
+        painter->setBrush(QColor(240, 240, 240));
+        painter->drawRoundedRect(details, 5, 5);
+
+        const QList<QPair<QString, QString>> rows = {
+            {"Длительность:", QString("%1 мин").arg(index.data(WorkoutListModel::DurationRole).toInt())},
+            {"Подходы:", QString::number(index.data(WorkoutListModel::SetsRole).toInt())},
+            {"Повторения:", QString::number(index.data(WorkoutListModel::RepsRole).toInt())},
+            {"Ккал:", QString::number(index.data(WorkoutListModel::CaloriesRole).toInt())}
+        };
+
+        painter->setFont(option.font);
+        for (int i = 0; i < rows.size(); ++i) {
+            const QRectF row(details.left() + TextInset, details.top() + DetailPadding + i * DetailRowHeight,
+                             details.width() - 2 * TextInset, DetailRowHeight);
+
+            painter->setPen(QColor("#505050"));
+            painter->drawText(QRectF(row.left(), row.top(), LabelWidth, row.height()),
+                              Qt::AlignLeft | Qt::AlignVCenter, rows[i].first);
+            painter->setPen(Qt::black);
+            painter->drawText(row.adjusted(LabelWidth, 0, 0, 0),
+                              Qt::AlignLeft | Qt::AlignVCenter, rows[i].second);
+        }
+
+        if (notesBlock > 0) {
+            const QRectF row(details.left() + TextInset, details.top() + DetailPadding + rows.size() * DetailRowHeight,
+                             details.width() - 2 * TextInset, notesBlock);
+
+            painter->setPen(QColor("#505050"));
+            painter->drawText(QRectF(row.left(), row.top(), LabelWidth, DetailRowHeight),
+                              Qt::AlignLeft | Qt::AlignVCenter, "Заметки:");
+            painter->setPen(Qt::black);
+            painter->drawText(row.adjusted(LabelWidth, 4, 0, -4),
+                              Qt::AlignLeft | Qt::AlignTop | Qt::TextWordWrap, notes);
+        }
+    }
+
+    painter->restore();
+}
+
+bool WorkoutCardDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                      const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    // Щелчок по заголовку раскрывает или сворачивает карточку
+    if (event->type() == QEvent::MouseButtonRelease) {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent*>(event);
+        if (mouseEvent->button() == Qt::LeftButton
+                && headerRect(option.rect).contains(mouseEvent->position())) {
+            const bool expanded = index.data(WorkoutListModel::ExpandedRole).toBool();
+            model->setData(index, !expanded, WorkoutListModel::ExpandedRole);
+            emit sizeHintChanged(index);
+            return true;
+        }
+    }
+    return QStyledItemDelegate::editorEvent(event, model, option, index);
+}
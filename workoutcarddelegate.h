@@ -0,0 +1,31 @@
+#ifndef WORKOUTCARDDELEGATE_H
+#define WORKOUTCARDDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+// Рисует карточку тренировки из WorkoutListModel: заголовок с типом
+// и краткой сводкой, под ним в раскрытом виде - таблица деталей
+// и заметки. Щелчок по заголовку раскрывает или сворачивает карточку;
+// свёрнутая карточка стоит только заголовка.
+class WorkoutCardDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit WorkoutCardDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+private:
+    QRectF cardRect(const QRect &itemRect) const;
+    QRectF headerRect(const QRect &itemRect) const;
+    int notesHeight(const QStyleOptionViewItem &option, const QString &notes, qreal cardWidth) const;
+};
+
+#endif // WORKOUTCARDDELEGATE_H
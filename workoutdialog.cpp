@@ -1,106 +1,16 @@
 #include "workoutdialog.h"
 #include <QLabel>
-#include <QApplication>
 
-WorkoutDialog::WorkoutDialog(QWidget *parent, bool isEditMode)
+WorkoutDialog::WorkoutDialog(QWidget *parent)
     : QDialog(parent)
 {
-    setWindowTitle(isEditMode ? "Редактирование тренировки" : "Добавить тренировку");
     setModal(true);
     resize(400, 300);
 
-    QApplication::setStyle("Fusion");
-
-    setStyleSheet(
-        // Базовые стили
-        "QDialog {"
-        "   background-color: #f5f5f5;"
-        "   font-family: Arial;"
-        "}"
-
-        "QLabel {"
-        "   font-weight: bold;"
-        "   color: #333;"
-        "}"
-
-        // Стили для элементов ввода
-        "QComboBox, QSpinBox, QLineEdit {"
-        "   padding: 5px;"
-        "   border: 1px solid #ccc;"
-        "   border-radius: 3px;"
-        "   background: white;"
-        "}"
-
-        // Стили для кнопок
-        "QPushButton {"
-        "   padding: 8px 15px;"
-        "   border-radius: 4px;"
-        "   font-weight: bold;"
-        "   min-width: 80px;"
-        "}"
-
-        "QSpinBox {"
-        "   padding-right: 20px;"
-        "}"
-
-        "QSpinBox::up-button {"
-        "   subcontrol-origin: border;"
-        "   subcontrol-position: top right;"
-        "   width: 20px;"
-        "   height: 8px;"
-
-        "}"
-        "QSpinBox::down-button {"
-        "   subcontrol-origin: border;"
-        "   subcontrol-position: bottom right;"
-        "   width: 20px;"
-        "   height: 8px;"
-        "}"
-
-
-        "QPushButton#saveButton:hover {"
-        "   background-color: #45a049;"
-        "}"
-
-        "QPushButton#cancelButton {"
-        "   background-color: #f44336;"
-        "   color: white;"
-        "   border: 1px solid #d32f2f;"
-        "}"
-
-        "QPushButton#cancelButton:hover {"
-        "   background-color: #d32f2f;"
-        "}"
-
-        "QComboBox QAbstractItemView {"
-        "   background: white;"
-        "   color: black;"
-        "   selection-background-color: #4CAF50;"
-        "   selection-color: white;"
-        "}"
-
-        "QComboBox {"
-        "   padding: 5px;"
-        "   border: 1px solid #ccc;"
-        "   border-radius: 3px;"
-        "   background: white;"
-        "   color: black;"
-        "}"
-        "QComboBox:hover {"
-        "   border: 1px solid #888;"
-        "   background: white;"
-        "   color: black;"
-        "}"
-        "QComboBox QAbstractItemView {"
-        "   background: white;"
-        "   color: black;"
-        "   selection-background-color: #4CAF50;"
-        "   selection-color: white;"
-        "   outline: none;"
-        "}"
-    );
+    // Оформление задаётся таблицей стилей приложения (theme.qss)
 
     QFormLayout *layout = new QFormLayout(this);
+    formLayout = layout;
     layout->setContentsMargins(20, 20, 20, 20);
     layout->setSpacing(15);
 
@@ -112,7 +22,8 @@ WorkoutDialog::WorkoutDialog(QWidget *parent, bool isEditMode)
     // Пользовательский тип
     customTypeEdit = new QLineEdit(this);
     customTypeEdit->setPlaceholderText("Введите тип тренировки");
-    customTypeEdit->setVisible(false);
+    layout->addRow(customTypeEdit);
+    layout->setRowVisible(customTypeEdit, false);
 
     // Длительность
     durationSpin = new QSpinBox(this);
@@ -158,14 +69,25 @@ WorkoutDialog::WorkoutDialog(QWidget *parent, bool isEditMode)
 
     connect(saveButton, &QPushButton::clicked, this, &QDialog::accept);
     connect(cancelButton, &QPushButton::clicked, this, &QDialog::reject);
-    connect(typeCombo, &QComboBox::currentTextChanged, [this](const QString &text){
-        customTypeEdit->setVisible(text == "Другое");
-        if (text == "Другое") {
-            static_cast<QFormLayout*>(this->layout())->insertRow(1, customTypeEdit);
-        } else {
-            customTypeEdit->setParent(nullptr);
-        }
+    connect(typeCombo, &QComboBox::currentTextChanged, this, [this](const QString &text){
+        formLayout->setRowVisible(customTypeEdit, text == "Другое");
     });
+
+    reset();
+}
+
+void WorkoutDialog::reset(bool isEditMode)
+{
+    setWindowTitle(isEditMode ? "Редактирование тренировки" : "Добавить тренировку");
+
+    typeCombo->setCurrentIndex(0);
+    customTypeEdit->clear();
+    durationSpin->setValue(durationSpin->minimum());
+    setsSpin->setValue(0);
+    repsSpin->setValue(0);
+    caloriesSpin->setValue(0);
+    notesEdit->clear();
+    typeCombo->setFocus();
 }
 
 // Реализации методов получения данных
@@ -206,7 +128,6 @@ void WorkoutDialog::setWorkoutData(const WorkoutData &workout)
     } else {
         typeCombo->setCurrentIndex(typeCombo->count() - 1);
         customTypeEdit->setText(workout.type);
-        customTypeEdit->setVisible(true);
     }
 
     durationSpin->setValue(workout.duration);
@@ -14,7 +14,10 @@ class WorkoutDialog : public QDialog
     Q_OBJECT
 
 public:
-    explicit WorkoutDialog(QWidget *parent = nullptr, bool isEditMode = false);
+    explicit WorkoutDialog(QWidget *parent = nullptr);
+
+    // Диалог создаётся один раз и перед каждым показом сбрасывается
+    void reset(bool isEditMode = false);
 
     QString getWorkoutType() const;
     QString getCustomType() const;
@@ -28,6 +31,7 @@ public:
 
 private:
     void setupUi();
+    QFormLayout *formLayout;
     QComboBox *typeCombo;
     QLineEdit *customTypeEdit;
     QSpinBox *durationSpin;
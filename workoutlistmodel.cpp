@@ -0,0 +1,145 @@
+#include "workoutlistmodel.h"
+
+WorkoutListModel::WorkoutListModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+void WorkoutListModel::setNotesLoader(const NotesLoader &loader)
+{
+    m_notesLoader = loader;
+}
+
+int WorkoutListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_workouts.size();
+}
+
+QVariant WorkoutListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_workouts.size()) return QVariant();
+
+    const WorkoutData &workout = m_workouts.at(index.row());
+    switch (role) {
+        case Qt::DisplayRole:
+        case TypeRole:
+            return workout.type;
+        case IdRole:
+            return workout.id;
+        case DurationRole:
+            return workout.duration;
+        case SetsRole:
+            return workout.sets;
+        case RepsRole:
+            return workout.reps;
+        case CaloriesRole:
+            return workout.calories;
+        case ExpandedRole:
+            return m_expanded.contains(workout.id);
+        case NotesRole:
+            return m_notesLoaded.contains(workout.id) ? workout.notes : QString();
+    }
+    return QVariant();
+}
+
+bool WorkoutListModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    // Снаружи меняется только состояние карточки
+    if (!index.isValid() || index.row() >= m_workouts.size() || role != ExpandedRole) return false;
+
+    const int id = m_workouts.at(index.row()).id;
+    if (value.toBool()) {
+        m_expanded.insert(id);
+        loadNotes(index.row());
+    } else {
+        m_expanded.remove(id);
+    }
+    emit dataChanged(index, index, {ExpandedRole, NotesRole});
+    return true;
+}
+
+void WorkoutListModel::setWorkouts(const QVector<WorkoutData> &workouts)
+{
+    beginResetModel();
+    m_workouts = workouts;
+    m_expanded.clear();
+    m_notesLoaded.clear();
+    endResetModel();
+}
+
+void WorkoutListModel::addWorkout(const WorkoutData &workout)
+{
+    const int row = m_workouts.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_workouts.append(workout);
+    // Заметки новой тренировки уже известны
+    m_notesLoaded.insert(workout.id);
+    endInsertRows();
+}
+
+bool WorkoutListModel::updateWorkout(const WorkoutData &workout)
+{
+    const int row = rowOf(workout.id);
+    if (row < 0) return false;
+
+    m_workouts[row] = workout;
+    m_notesLoaded.insert(workout.id);
+    const QModelIndex changed = index(row);
+    emit dataChanged(changed, changed);
+    return true;
+}
+
+bool WorkoutListModel::removeWorkout(int id)
+{
+    const int row = rowOf(id);
+    if (row < 0) return false;
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_workouts.removeAt(row);
+    m_expanded.remove(id);
+    m_notesLoaded.remove(id);
+    endRemoveRows();
+    return true;
+}
+
+bool WorkoutListModel::changeId(int oldId, int newId)
+{
+    const int row = rowOf(oldId);
+    if (row < 0) return false;
+
+    m_workouts[row].id = newId;
+    if (m_expanded.remove(oldId)) {
+        m_expanded.insert(newId);
+    }
+    if (m_notesLoaded.remove(oldId)) {
+        m_notesLoaded.insert(newId);
+    }
+    const QModelIndex changed = index(row);
+    emit dataChanged(changed, changed, {IdRole});
+    return true;
+}
+
+void WorkoutListModel::loadNotes(int row)
+{
+    WorkoutData &workout = m_workouts[row];
+    if (m_notesLoaded.contains(workout.id)) return;
+
+    if (m_notesLoader) {
+        workout.notes = m_notesLoader(workout.id);
+    }
+    m_notesLoaded.insert(workout.id);
+}
+
+int WorkoutListModel::rowOf(int id) const
+{
+    // В списке тренировки одного дня, их единицы
+    for (int row = 0; row < m_workouts.size(); ++row) {
+        if (m_workouts.at(row).id == id) return row;
+    }
+    return -1;
+}
+
+int WorkoutListModel::workoutId(const QModelIndex &index) const
+{
+    return index.isValid() ? data(index, IdRole).toInt() : -1;
+}
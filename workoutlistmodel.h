@@ -0,0 +1,60 @@
+#ifndef WORKOUTLISTMODEL_H
+#define WORKOUTLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+#include <QSet>
+#include <functional>
+#include "mainwindow.h"
+
+// Тренировки выбранного дня для списка карточек. Смена дня - сброс
+// модели, добавление и удаление - вставка и удаление одной строки.
+// Модель помнит, какие карточки раскрыты.
+//
+// Заметки не читаются при смене дня: загрузчик вызывается при первом
+// раскрытии карточки, дальше текст берётся из модели.
+class WorkoutListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        IdRole = Qt::UserRole + 1,
+        TypeRole,
+        DurationRole,
+        SetsRole,
+        RepsRole,
+        CaloriesRole,
+        ExpandedRole,
+        NotesRole       // пусто, пока карточку не раскрывали
+    };
+
+    using NotesLoader = std::function<QString(int id)>;
+
+    explicit WorkoutListModel(QObject *parent = nullptr);
+
+    void setNotesLoader(const NotesLoader &loader);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+
+    void setWorkouts(const QVector<WorkoutData> &workouts);
+    void addWorkout(const WorkoutData &workout);
+    bool updateWorkout(const WorkoutData &workout);
+    bool removeWorkout(int id);
+    bool changeId(int oldId, int newId);
+
+    int rowOf(int id) const;
+    int workoutId(const QModelIndex &index) const;
+
+private:
+    void loadNotes(int row);
+
+    QVector<WorkoutData> m_workouts;
+    QSet<int> m_expanded;
+    QSet<int> m_notesLoaded;
+    NotesLoader m_notesLoader;
+};
+
+#endif // WORKOUTLISTMODEL_H
@@ -0,0 +1,229 @@
+#include "workoutrepository.h"
+#include "database.h"
+#include "databasewriter.h"
+#include "workoutstore.h"
+#include "rangeindex.h"
+#include <QFuture>
+
+WorkoutRepository::WorkoutRepository(Database *database, DatabaseWriter *writer, QObject *parent)
+    : QObject(parent), database(database), writer(writer),
+      store(new WorkoutStore()), index(new RangeIndex())
+{
+    store->setNotesLoader([this](int id) {
+        return this->database->getWorkoutNotes(id);
+    });
+
+    // Суммы для статистики: дерево вида спорта строится из дневной сводки
+    index->setLoader([this](const QString &type) {
+        return this->database->getRollups(type, QDate(), QDate());
+    });
+}
+
+WorkoutRepository::~WorkoutRepository()
+{
+    delete store;
+    delete index;
+}
+
+quint64 WorkoutRepository::revision() const
+{
+    return m_revision;
+}
+
+RangeIndex *WorkoutRepository::rangeIndex() const
+{
+    return index;
+}
+
+void WorkoutRepository::ensureLoaded(const QDate &from, const QDate &to)
+{
+    if (m_loadedFrom.isValid() && from >= m_loadedFrom && to <= m_loadedTo) {
+        return;
+    }
+
+    // Диапазон не примыкает к загруженному — загружаем его заново
+    if (!m_loadedFrom.isValid()
+        || to < m_loadedFrom.addDays(-1)
+        || from > m_loadedTo.addDays(1)) {
+        // База должна содержать все изменения, уже показанные в памяти.
+        // Суммы перестраиваются из сводки, откаты старых операций не нужны.
+        const bool flushed = m_pendingWrites > 0;
+        if (flushed) {
+            writer->sync().waitForFinished();
+            index->clear();
+            ++m_generation;
+        }
+
+        store->clear();
+        database->getWorkoutsInRange(from, to, *store);
+        m_loadedFrom = from;
+        m_loadedTo = to;
+
+        if (flushed) {
+            ++m_revision;
+            emit reset();
+        }
+        return;
+    }
+
+    // Иначе догружаем только недостающую часть
+    if (from < m_loadedFrom) {
+        database->getWorkoutsInRange(from, m_loadedFrom.addDays(-1), *store);
+        m_loadedFrom = from;
+    }
+    if (to > m_loadedTo) {
+        database->getWorkoutsInRange(m_loadedTo.addDays(1), to, *store);
+        m_loadedTo = to;
+    }
+}
+
+bool WorkoutRepository::isLoaded(const QDate &date) const
+{
+    return m_loadedFrom.isValid() && date >= m_loadedFrom && date <= m_loadedTo;
+}
+
+bool WorkoutRepository::contains(int id) const
+{
+    return store->contains(id);
+}
+
+int WorkoutRepository::resolveId(int id) const
+{
+    if (store->contains(id)) return id;
+
+    // Временный id мог быть уже заменён настоящим
+    const int resolvedId = m_resolvedIds.value(id, id);
+    return store->contains(resolvedId) ? resolvedId : -1;
+}
+
+WorkoutData WorkoutRepository::workout(int id) const
+{
+    return store->workout(id);
+}
+
+QString WorkoutRepository::notes(int id) const
+{
+    return store->notes(id);
+}
+
+QVector<WorkoutData> WorkoutRepository::workoutsOn(const QDate &day) const
+{
+    return store->workoutsOn(day);
+}
+
+void WorkoutRepository::insertLocal(const WorkoutData &workout)
+{
+    // Тренировка уже могла вернуться из базы при перечитывании диапазона
+    if (store->contains(workout.id)) return;
+
+    if (isLoaded(workout.date)) {
+        store->insert(workout);
+    }
+    index->insert(workout);
+    ++m_revision;
+    emit workoutAdded(workout.id, workout.date, workout.type);
+}
+
+bool WorkoutRepository::updateLocal(const WorkoutData &workout, WorkoutData *previous)
+{
+    if (!store->contains(workout.id)) return false;
+
+    const WorkoutData old = store->workout(workout.id);
+    store->update(workout);
+    index->remove(old);
+    index->insert(workout);
+    if (previous) *previous = old;
+
+    ++m_revision;
+    emit workoutUpdated(workout.id, workout.date, workout.type, old.type);
+    return true;
+}
+
+bool WorkoutRepository::removeLocal(int id, WorkoutData *removed)
+{
+    WorkoutData workout;
+    if (!store->remove(id, &workout)) return false;
+
+    index->remove(workout);
+    if (removed) *removed = workout;
+
+    ++m_revision;
+    emit workoutRemoved(workout.id, workout.date, workout.type);
+    return true;
+}
+
+void WorkoutRepository::add(WorkoutData workout)
+{
+    // Показываем тренировку сразу, с временным id до ответа базы
+    workout.id = m_nextProvisionalId--;
+    insertLocal(workout);
+
+    const int provisionalId = workout.id;
+    const int generation = m_generation;
+    ++m_pendingWrites;
+    writer->addWorkout(workout).then(this, [this, provisionalId, generation](int id) {
+        --m_pendingWrites;
+        if (id < 0) {
+            if (generation == m_generation) removeLocal(provisionalId);
+            return;
+        }
+
+        m_resolvedIds.insert(provisionalId, id);
+        store->changeId(provisionalId, id);
+        emit idChanged(provisionalId, id);
+    });
+}
+
+void WorkoutRepository::update(const WorkoutData &workout)
+{
+    // Изменения видны сразу, при ошибке записи откатываем их
+    WorkoutData previous;
+    if (!updateLocal(workout, &previous)) return;
+
+    const int generation = m_generation;
+    ++m_pendingWrites;
+    writer->updateWorkout(workout).then(this, [this, previous, generation](bool ok) {
+        --m_pendingWrites;
+        if (ok || generation != m_generation) return;
+
+        WorkoutData restored = previous;
+        restored.id = m_resolvedIds.value(previous.id, previous.id);
+        updateLocal(restored);
+    });
+}
+
+void WorkoutRepository::remove(int id)
+{
+    // Удаляем сразу, при ошибке записи возвращаем тренировку на место
+    WorkoutData removed;
+    if (!removeLocal(id, &removed)) return;
+
+    const int generation = m_generation;
+    ++m_pendingWrites;
+    writer->deleteWorkout(removed.id).then(this, [this, removed, generation](bool ok) {
+        --m_pendingWrites;
+        if (ok || generation != m_generation) return;
+
+        WorkoutData restored = removed;
+        restored.id = m_resolvedIds.value(removed.id, removed.id);
+        insertLocal(restored);
+    });
+}
+
+void WorkoutRepository::addImported(const QVector<WorkoutData> &workouts)
+{
+    // В память добавляем одним шагом только то, что попадает в загруженный диапазон
+    QVector<WorkoutData> loaded;
+    for (const WorkoutData &workout : workouts) {
+        if (isLoaded(workout.date)) {
+            loaded.append(workout);
+        }
+    }
+    store->insert(loaded);
+
+    // После пакетной записи деревья проще перечитать из сводки
+    index->clear();
+
+    ++m_revision;
+    emit reset();
+}
@@ -0,0 +1,86 @@
+#ifndef WORKOUTREPOSITORY_H
+#define WORKOUTREPOSITORY_H
+
+#include <QObject>
+#include <QHash>
+#include <QDate>
+#include <QVector>
+#include "mainwindow.h"
+
+class Database;
+class DatabaseWriter;
+class WorkoutStore;
+class RangeIndex;
+
+// Единственный владелец тренировок в памяти: загруженный диапазон дней
+// (WorkoutStore) и суммы для статистики (RangeIndex).
+//
+// Изменения применяются сразу, запись в базу идёт через DatabaseWriter,
+// при ошибке записи изменение откатывается. О каждом изменении, в том
+// числе об откате, сообщает сигнал с id, днём и видом спорта, чтобы
+// представления обновляли только затронутый день или период.
+// revision() растёт при любом изменении данных.
+class WorkoutRepository : public QObject
+{
+    Q_OBJECT
+
+public:
+    WorkoutRepository(Database *database, DatabaseWriter *writer, QObject *parent = nullptr);
+    ~WorkoutRepository();
+
+    quint64 revision() const;
+    RangeIndex *rangeIndex() const;
+
+    // Догружает дни из базы; старый диапазон сбрасывается, если новый к нему не примыкает.
+    // Перед сбросом дожидается незаписанных изменений, иначе перечитанный
+    // диапазон вернул бы удалённые и потерял добавленные тренировки.
+    void ensureLoaded(const QDate &from, const QDate &to);
+
+    bool contains(int id) const;
+    // Временный id, уже заменённый настоящим, тоже находится
+    int resolveId(int id) const;
+    WorkoutData workout(int id) const;
+    QString notes(int id) const;
+    QVector<WorkoutData> workoutsOn(const QDate &day) const;
+
+    // Тренировке назначается временный id до ответа базы
+    void add(WorkoutData workout);
+    void update(const WorkoutData &workout);
+    void remove(int id);
+
+    // Тренировки уже записаны импортом в базу
+    void addImported(const QVector<WorkoutData> &workouts);
+
+signals:
+    void workoutAdded(int id, const QDate &date, const QString &type);
+    // previousType - вид спорта до изменения, статистику нужно сбросить для обоих
+    void workoutUpdated(int id, const QDate &date, const QString &type, const QString &previousType);
+    void workoutRemoved(int id, const QDate &date, const QString &type);
+    // База назначила настоящий id добавленной тренировке
+    void idChanged(int provisionalId, int id);
+    // Изменилось сразу много дней, представления перечитывают всё
+    void reset();
+
+private:
+    void insertLocal(const WorkoutData &workout);
+    bool updateLocal(const WorkoutData &workout, WorkoutData *previous = nullptr);
+    bool removeLocal(int id, WorkoutData *removed = nullptr);
+    bool isLoaded(const QDate &date) const;
+
+    Database *database;
+    DatabaseWriter *writer;
+    WorkoutStore *store;
+    RangeIndex *index;
+    quint64 m_revision = 0;
+    // Операции, поставленные в очередь записи и ещё не вернувшие ответ
+    int m_pendingWrites = 0;
+    // Растёт, когда тренировки и суммы перечитываются из базы после
+    // записи очереди; ответы на более ранние операции уже учтены в базе
+    int m_generation = 0;
+    QDate m_loadedFrom;
+    QDate m_loadedTo;
+    int m_nextProvisionalId = -2;
+    QHash<int, int> m_resolvedIds;
+};
+
+#endif // WORKOUTREPOSITORY_H
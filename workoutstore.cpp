@@ -0,0 +1,219 @@
+#include "workoutstore.h"
+
+int WorkoutStore::size() const
+{
+    return m_slotById.size();
+}
+
+bool WorkoutStore::isEmpty() const
+{
+    return m_slotById.isEmpty();
+}
+
+void WorkoutStore::clear()
+{
+    m_ids.clear();
+    m_days.clear();
+    m_typeIds.clear();
+    m_durations.clear();
+    m_sets.clear();
+    m_reps.clear();
+    m_calories.clear();
+    m_notes.clear();
+    m_freeSlots.clear();
+    m_slotById.clear();
+    m_slotsByDay.clear();
+}
+
+void WorkoutStore::setNotesLoader(const NotesLoader &loader)
+{
+    m_notesLoader = loader;
+}
+
+int WorkoutStore::internType(const QString &type)
+{
+    auto it = m_typeIdByName.constFind(type);
+    if (it != m_typeIdByName.constEnd()) return it.value();
+
+    const int id = m_typeNames.size();
+    m_typeNames.append(type);
+    m_typeIdByName.insert(type, id);
+    return id;
+}
+
+void WorkoutStore::insert(const WorkoutData &workout, bool notesLoaded)
+{
+    const int day = int(workout.date.toJulianDay());
+    const int type = internType(workout.type);
+
+    int slot;
+    if (!m_freeSlots.isEmpty()) {
+        slot = m_freeSlots.takeLast();
+        m_ids[slot] = workout.id;
+        m_days[slot] = day;
+        m_typeIds[slot] = type;
+        m_durations[slot] = workout.duration;
+        m_sets[slot] = workout.sets;
+        m_reps[slot] = workout.reps;
+        m_calories[slot] = workout.calories;
+    } else {
+        slot = m_ids.size();
+        m_ids.append(workout.id);
+        m_days.append(day);
+        m_typeIds.append(type);
+        m_durations.append(workout.duration);
+        m_sets.append(workout.sets);
+        m_reps.append(workout.reps);
+        m_calories.append(workout.calories);
+    }
+
+    if (notesLoaded) {
+        m_notes.insert(workout.id, workout.notes);
+    }
+
+    m_slotById.insert(workout.id, slot);
+    m_slotsByDay[day].append(slot);
+}
+
+void WorkoutStore::insert(const QVector<WorkoutData> &workouts)
+{
+    m_slotById.reserve(m_slotById.size() + workouts.size());
+    for (const WorkoutData &workout : workouts) {
+        insert(workout);
+    }
+}
+
+bool WorkoutStore::update(const WorkoutData &workout)
+{
+    auto it = m_slotById.constFind(workout.id);
+    if (it == m_slotById.constEnd()) return false;
+
+    const int slot = it.value();
+    const int newDay = int(workout.date.toJulianDay());
+
+    // При смене даты слот переезжает в другой день
+    if (m_days[slot] != newDay) {
+        QVector<int> &oldSlots = m_slotsByDay[m_days[slot]];
+        oldSlots.removeOne(slot);
+        if (oldSlots.isEmpty()) m_slotsByDay.remove(m_days[slot]);
+        m_slotsByDay[newDay].append(slot);
+    }
+
+    m_days[slot] = newDay;
+    m_typeIds[slot] = internType(workout.type);
+    m_durations[slot] = workout.duration;
+    m_sets[slot] = workout.sets;
+    m_reps[slot] = workout.reps;
+    m_calories[slot] = workout.calories;
+    m_notes.insert(workout.id, workout.notes);
+    return true;
+}
+
+bool WorkoutStore::remove(int id, WorkoutData *removed)
+{
+    auto it = m_slotById.find(id);
+    if (it == m_slotById.end()) return false;
+
+    const int slot = it.value();
+    if (removed) {
+        *removed = workoutAt(slot);
+        removed->notes = notes(id);
+    }
+
+    m_slotById.erase(it);
+    m_notes.remove(id);
+
+    QVector<int> &daySlots = m_slotsByDay[m_days[slot]];
+    daySlots.removeOne(slot);
+    if (daySlots.isEmpty()) m_slotsByDay.remove(m_days[slot]);
+
+    m_ids[slot] = -1;
+    m_typeIds[slot] = -1;
+    m_freeSlots.append(slot);
+    return true;
+}
+
+bool WorkoutStore::changeId(int oldId, int newId)
+{
+    auto it = m_slotById.find(oldId);
+    if (it == m_slotById.end()) return false;
+
+    const int slot = it.value();
+    m_slotById.erase(it);
+    m_slotById.insert(newId, slot);
+    m_ids[slot] = newId;
+
+    auto notesIt = m_notes.find(oldId);
+    if (notesIt != m_notes.end()) {
+        m_notes.insert(newId, notesIt.value());
+        m_notes.erase(notesIt);
+    }
+    return true;
+}
+
+bool WorkoutStore::contains(int id) const
+{
+    return m_slotById.contains(id);
+}
+
+WorkoutData WorkoutStore::workout(int id) const
+{
+    auto it = m_slotById.constFind(id);
+    if (it == m_slotById.constEnd()) return WorkoutData();
+
+    WorkoutData result = workoutAt(it.value());
+    result.notes = notes(id);
+    return result;
+}
+
+QString WorkoutStore::notes(int id) const
+{
+    auto it = m_notes.constFind(id);
+    if (it != m_notes.constEnd()) return it.value();
+
+    if (!m_notesLoader || !m_slotById.contains(id)) return QString();
+
+    const QString loaded = m_notesLoader(id);
+    m_notes.insert(id, loaded);
+    return loaded;
+}
+
+WorkoutData WorkoutStore::workoutAt(int slot) const
+{
+    WorkoutData workout;
+    workout.id = m_ids[slot];
+    workout.type = m_typeNames.value(m_typeIds[slot]);
+    workout.duration = m_durations[slot];
+    workout.sets = m_sets[slot];
+    workout.reps = m_reps[slot];
+    workout.calories = m_calories[slot];
+    workout.notes = m_notes.value(workout.id);
+    workout.date = QDate::fromJulianDay(m_days[slot]);
+    return workout;
+}
+
+QVector<WorkoutData> WorkoutStore::workoutsOn(const QDate &day) const
+{
+    QVector<WorkoutData> result;
+    auto it = m_slotsByDay.constFind(int(day.toJulianDay()));
+    if (it == m_slotsByDay.constEnd()) return result;
+
+    result.reserve(it.value().size());
+    for (int slot : it.value()) {
+        result.append(workoutAt(slot));
+    }
+    return result;
+}
+
+QVector<WorkoutData> WorkoutStore::workoutsInRange(const QDate &from, const QDate &to) const
+{
+    QVector<WorkoutData> result;
+    auto it = m_slotsByDay.lowerBound(int(from.toJulianDay()));
+    auto end = m_slotsByDay.upperBound(int(to.toJulianDay()));
+    for (; it != end; ++it) {
+        for (int slot : it.value()) {
+            result.append(workoutAt(slot));
+        }
+    }
+    return result;
+}
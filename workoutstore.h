@@ -0,0 +1,72 @@
+#ifndef WORKOUTSTORE_H
+#define WORKOUTSTORE_H
+
+#include <QMap>
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+#include <QDate>
+#include <functional>
+#include "mainwindow.h"
+
+// Тренировки в памяти в колоночном виде: каждое поле хранится
+// в своём массиве, индекс в массивах - слот записи. Освобождённые
+// слоты переиспользуются.
+//
+// Тип тренировки хранится как id в словаре типов, строка на запись
+// не копируется. Заметки читаются лениво
+// через загрузчик и кэшируются по id тренировки.
+//
+// Индексы: день (номер юлианского дня) -> слоты и id -> слот.
+class WorkoutStore
+{
+public:
+    using NotesLoader = std::function<QString(int id)>;
+
+    int size() const;
+    bool isEmpty() const;
+    void clear();
+
+    void setNotesLoader(const NotesLoader &loader);
+
+    // notesLoaded = false - заметки будут прочитаны загрузчиком при обращении
+    void insert(const WorkoutData &workout, bool notesLoaded = true);
+    void insert(const QVector<WorkoutData> &workouts);
+    bool update(const WorkoutData &workout);
+    bool remove(int id, WorkoutData *removed = nullptr);
+    bool changeId(int oldId, int newId);
+
+    bool contains(int id) const;
+    WorkoutData workout(int id) const;
+    QString notes(int id) const;
+
+    // Заметки в этих выборках заполнены, только если уже загружены
+    QVector<WorkoutData> workoutsOn(const QDate &day) const;
+    QVector<WorkoutData> workoutsInRange(const QDate &from, const QDate &to) const;
+
+private:
+    int internType(const QString &type);
+    WorkoutData workoutAt(int slot) const;
+
+    // Колонки
+    QVector<int> m_ids;
+    QVector<int> m_days;
+    QVector<int> m_typeIds;
+    QVector<int> m_durations;
+    QVector<int> m_sets;
+    QVector<int> m_reps;
+    QVector<int> m_calories;
+
+    // Словарь типов
+    QStringList m_typeNames;
+    QHash<QString, int> m_typeIdByName;
+
+    mutable QHash<int, QString> m_notes;
+    NotesLoader m_notesLoader;
+
+    QVector<int> m_freeSlots;
+    QHash<int, int> m_slotById;
+    QMap<int, QVector<int>> m_slotsByDay;
+};
+
+#endif // WORKOUTSTORE_H